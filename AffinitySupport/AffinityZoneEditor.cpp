@@ -5,6 +5,7 @@
 #include "AffinitySupport/AffinityZoneEditor.hpp"
 #include "AffinitySupport/CpuSelectionWidget.hpp"
 #include "HostExplorer/HostExplorerDock.hpp"
+#include "HostExplorer/RemoteEnvironmentPool.hpp"
 #include <Pothos/Remote.hpp>
 #include <Pothos/Proxy.hpp>
 #include <Poco/Logger.h>
@@ -31,9 +32,11 @@ AffinityZoneEditor::AffinityZoneEditor(const QString &zoneName, QWidget *parent,
     _prioritySpin(new QSpinBox(this)),
     _cpuSelection(nullptr),
     _cpuSelectionContainer(new QVBoxLayout()),
-    _yieldModeBox(new QComboBox(this))
+    _yieldModeBox(new QComboBox(this)),
+    _loadMonitor(new HostLoadMonitor(this))
 {
     assert(_hostExplorerDock != nullptr);
+    connect(_loadMonitor, &HostLoadMonitor::loadSampled, this, &AffinityZoneEditor::handleLoadSampled);
 
     //bold title
     this->setStyleSheet("QGroupBox{font-weight: bold;}");
@@ -214,14 +217,25 @@ void AffinityZoneEditor::updateCpuSelection(void)
     auto uriStr = _hostsBox->itemText(_hostsBox->currentIndex());
     if (_uriToNumaInfo[uriStr].empty()) try
     {
-        auto env = Pothos::RemoteClient(uriStr.toStdString()).makeEnvironment("managed");
+        auto env = RemoteEnvironmentPool::global().getEnvironment(uriStr);
         auto nodeInfos = env->findProxy("Pothos/System/NumaInfo").call<std::vector<Pothos::System::NumaInfo>>("get");
         _uriToNumaInfo[uriStr] = nodeInfos;
     }
-    catch (const Pothos::Exception &){}
+    catch (const Pothos::Exception &)
+    {
+        RemoteEnvironmentPool::global().invalidate(uriStr);
+    }
 
     delete _cpuSelection;
     _cpuSelection = new CpuSelectionWidget(_uriToNumaInfo[uriStr], this);
     connect(_cpuSelection, &CpuSelectionWidget::selectionChanged, this, &AffinityZoneEditor::handleSpinSelChanged);
     _cpuSelectionContainer->addWidget(_cpuSelection);
+
+    //shade the cpus with the live load of the selected host
+    _loadMonitor->setUri(uriStr);
+}
+
+void AffinityZoneEditor::handleLoadSampled(const HostLoad &load)
+{
+    if (_cpuSelection != nullptr) _cpuSelection->setLoad(load);
 }
@@ -7,6 +7,7 @@
 #include <QColor>
 #include <QJsonObject>
 #include <Pothos/System/NumaInfo.hpp>
+#include "HostExplorer/HostLoadMonitor.hpp"
 #include <vector>
 #include <map>
 
@@ -74,6 +75,8 @@ private slots:
         emit this->settingsChanged();
     }
 
+    void handleLoadSampled(const HostLoad &load);
+
 private:
 
     void selectThisUri(const QString &uri);
@@ -90,6 +93,7 @@ private:
     CpuSelectionWidget *_cpuSelection;
     QVBoxLayout *_cpuSelectionContainer;
     QComboBox *_yieldModeBox;
+    HostLoadMonitor *_loadMonitor;
 
     std::map<QString, std::vector<Pothos::System::NumaInfo>> _uriToNumaInfo;
 };
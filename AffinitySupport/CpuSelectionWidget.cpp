@@ -6,7 +6,8 @@
 #include <QTableWidget>
 #include <QHeaderView>
 #include <QVBoxLayout>
-#include <algorithm>
+#include <QColor>
+#include <algorithm> //min/max
 
 static const int COL_MAX = 4;
 
@@ -94,12 +95,28 @@ void CpuSelectionWidget::update(void)
         }
     }
 
-    //recolor and select every block
+    //recolor and select every block, unselected cpus are shaded by load
     for (const auto &pair : _itemToSelected)
     {
         if (numaNodeSelected and _cpuItems.count(pair.first) != 0) pair.first->setFlags(Qt::NoItemFlags);
         else pair.first->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
-        pair.first->setBackgroundColor((pair.second)?Qt::green:Qt::white);
+        QColor color((pair.second)?Qt::green:Qt::white);
+        const auto num = _itemToNum[pair.first];
+        const auto usageIt = _load.cpuUsage.find(num);
+        if (_cpuItems.count(pair.first) != 0 and usageIt != _load.cpuUsage.end())
+        {
+            const int shade = int(255*(1.0 - std::min(std::max(usageIt->second, 0.0), 1.0)));
+            if (not pair.second) color = QColor(255, shade, shade);
+            pair.first->setToolTip(tr("CPU %1: %2% utilized").arg(num).arg(usageIt->second*100, 0, 'f', 1));
+        }
+        for (const auto &numaInfo : _load.numaInfo)
+        {
+            if (_nodeItems.count(pair.first) == 0 or size_t(numaInfo.nodeNumber) != num or numaInfo.totalMemory == 0) continue;
+            pair.first->setToolTip(tr("Node %1: %2 of %3 MB used").arg(num)
+                .arg((numaInfo.totalMemory - numaInfo.freeMemory)/1024/1024)
+                .arg(numaInfo.totalMemory/1024/1024));
+        }
+        pair.first->setBackgroundColor(color);
         pair.first->setSelected(false);
     }
 
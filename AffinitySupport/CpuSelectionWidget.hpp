@@ -3,6 +3,7 @@
 
 #pragma once
 #include <Pothos/Config.hpp>
+#include "HostExplorer/HostLoadMonitor.hpp"
 #include <QWidget>
 #include <QString>
 #include <Pothos/System.hpp>
@@ -17,6 +18,7 @@ class QTableWidgetItem;
 
 /*!
  * A table-based display to select a finite number of integers.
+ * Unselected CPUs are shaded by their utilization from the live load.
  */
 class CpuSelectionWidget : public QWidget
 {
@@ -79,6 +81,13 @@ public:
         return nums;
     }
 
+    //! Show the live load of the host
+    void setLoad(const HostLoad &load)
+    {
+        _load = load;
+        this->update();
+    }
+
 signals:
     void selectionChanged(void);
 
@@ -95,4 +104,5 @@ private:
     std::set<QTableWidgetItem *> _cpuItems, _nodeItems;
     QTableWidget *_table;
     QLabel *_label;
+    HostLoad _load;
 };
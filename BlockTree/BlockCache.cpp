@@ -3,18 +3,168 @@
 
 #include "BlockTree/BlockCache.hpp"
 #include "HostExplorer/HostExplorerDock.hpp"
+#include "HostExplorer/RemoteEnvironmentPool.hpp"
+#include "HostExplorer/PluginRegistryCache.hpp"
 #include "MainWindow/MainSplash.hpp"
+#include <Pothos/System/Version.hpp> //POTHOS_API_VERSION
 #include <Pothos/Remote.hpp>
 #include <Pothos/Proxy.hpp>
+#include <Pothos/Plugin.hpp>
 #include <QJsonDocument>
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QSaveFile>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
 #include <QFuture>
 #include <QFutureWatcher>
 #include <QReadWriteLock>
+#include <QElapsedTimer>
+#include <QThreadPool>
 #include <QtConcurrent/QtConcurrent>
 #include <Poco/Logger.h>
+#include <Poco/URI.h>
+#include <Poco/Net/IPAddress.h>
 #include <iostream>
+#include <condition_variable>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <set>
 #include <map>
 
+//! Max time to wait on the nodes for a block description not in the cache
+static const long QUERY_TIMEOUT_MS = 3000;
+
+//! Remember block paths that were not found on any node for this long
+static const qint64 MISS_CACHE_TTL_MS = 30000;
+
+#if POTHOS_API_VERSION >= 0x00070000
+#define HAS_MODULE_VERSION
+#endif
+
+/***********************************************************************
+ * Persistent cache of block descriptions per host
+ **********************************************************************/
+static QString getBlockCacheFilePath(const QString &uri)
+{
+    const QDir cacheDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+    const auto uriHash = QCryptographicHash::hash(uri.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return cacheDir.absoluteFilePath(QString("BlockCache/%1.json").arg(QString::fromLatin1(uriHash)));
+}
+
+static QJsonObject loadBlockCacheFile(const QString &uri)
+{
+    QFile file(getBlockCacheFilePath(uri));
+    if (not file.open(QIODevice::ReadOnly)) return QJsonObject();
+    const auto cacheObj = QJsonDocument::fromJson(file.readAll()).object();
+
+    //guard against hash collisions and hand edited files
+    if (cacheObj["uri"].toString() != uri) return QJsonObject();
+    return cacheObj;
+}
+
+static void saveBlockCacheFile(const QString &uri, const QString &fingerprint, const QJsonArray &blockDescs)
+{
+    QJsonObject cacheObj;
+    cacheObj["uri"] = uri;
+    cacheObj["fingerprint"] = fingerprint;
+    cacheObj["blockDescs"] = blockDescs;
+
+    //write to a temporary file and rename so a crash never leaves a partial cache
+    const auto path = getBlockCacheFilePath(uri);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (file.open(QIODevice::WriteOnly) and
+        file.write(QJsonDocument(cacheObj).toJson(QJsonDocument::Compact)) >= 0 and
+        file.commit()) return;
+
+    static auto &logger = Poco::Logger::get("PothosFlow.BlockCache");
+    logger.warning("Failed to write block cache %s - %s", path.toStdString(), file.errorString().toStdString());
+}
+
+/***********************************************************************
+ * Fingerprint the block plugins of a node
+ **********************************************************************/
+static void hashRegistryDump(QCryptographicHash &hash, std::set<std::string> &modulePaths, const Pothos::PluginRegistryInfoDump &dump)
+{
+    if (not dump.objectType.empty())
+    {
+        hash.addData(dump.pluginPath.data(), int(dump.pluginPath.size()));
+        hash.addData(dump.modulePath.data(), int(dump.modulePath.size()));
+        #ifdef HAS_MODULE_VERSION
+        hash.addData(dump.moduleVersion.data(), int(dump.moduleVersion.size()));
+        #endif
+        if (not dump.modulePath.empty()) modulePaths.insert(dump.modulePath);
+    }
+
+    for (const auto &subInfo : dump.subInfo)
+    {
+        hashRegistryDump(hash, modulePaths, subInfo);
+    }
+}
+
+static bool isLoopbackUri(const QString &uri)
+{
+    const auto host = Poco::URI(uri.toStdString()).getHost();
+    if (host == "localhost") return true;
+    try
+    {
+        return Poco::Net::IPAddress(host).isLoopback();
+    }
+    catch (const Poco::Exception &)
+    {
+        return false;
+    }
+}
+
+/*!
+ * Get the size and modification time of the module files.
+ * A module rebuilt in place keeps its plugin paths and version,
+ * but the file changes. The flow module stats the files on the host.
+ * Hosts without the flow module are only checked when they are local.
+ */
+static QByteArray queryModuleFileStats(Pothos::ProxyEnvironment::Sptr env, const QString &uri, const std::set<std::string> &modulePaths)
+{
+    std::string paths;
+    for (const auto &path : modulePaths) paths += path + "\n";
+    try
+    {
+        const std::string stats = env->findProxy("Pothos/Flow/FileInfo").call("statJson", paths);
+        return QByteArray(stats.data(), int(stats.size()));
+    }
+    catch (const Pothos::Exception &){}
+
+    QByteArray stats;
+    if (not isLoopbackUri(uri)) return stats;
+    for (const auto &path : modulePaths)
+    {
+        const QFileInfo info(QString::fromStdString(path));
+        stats += QByteArray::number(info.size()) + "," + QByteArray::number(info.lastModified().toMSecsSinceEpoch()) + ";";
+    }
+    return stats;
+}
+
+/*!
+ * The fingerprint changes when a plugin is added, removed,
+ * or moved to a different module or module version,
+ * or when a module file is rebuilt.
+ * The registry dump is much smaller than the JSON docs,
+ * so this is a cheap way to revalidate the cached docs.
+ * The dump is always fresh, and it refreshes the host explorer's registry cache.
+ */
+static QString queryRegistryFingerprint(Pothos::ProxyEnvironment::Sptr env, const QString &uri)
+{
+    const auto dump = PluginRegistryCache::global().get(uri, true/*refresh*/);
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    std::set<std::string> modulePaths;
+    hashRegistryDump(hash, modulePaths, *dump);
+    hash.addData(queryModuleFileStats(env, uri, modulePaths));
+    return QString::fromLatin1(hash.result().toHex());
+}
+
 /***********************************************************************
  * Query JSON docs from node
  **********************************************************************/
@@ -22,16 +172,24 @@ static QJsonArray queryBlockDescs(const QString &uri)
 {
     try
     {
-        auto client = Pothos::RemoteClient(uri.toStdString());
-        auto env = client.makeEnvironment("managed");
+        auto env = RemoteEnvironmentPool::global().getEnvironment(uri);
+
+        //the cached docs are still valid when the plugins did not change
+        const auto fingerprint = queryRegistryFingerprint(env, uri);
+        const auto cacheObj = loadBlockCacheFile(uri);
+        if (cacheObj["fingerprint"].toString() == fingerprint) return cacheObj["blockDescs"].toArray();
+
         const std::string json = env->findProxy("Pothos/Util/DocUtils").call("dumpJson");
         QJsonParseError errorParser;
         const auto jsonDoc = QJsonDocument::fromJson(QByteArray(json.data(), json.size()), &errorParser);
         if (jsonDoc.isNull()) throw Pothos::Exception(errorParser.errorString().toStdString());
+        saveBlockCacheFile(uri, fingerprint, jsonDoc.array());
         return jsonDoc.array();
     }
     catch (const Pothos::Exception &ex)
     {
+        RemoteEnvironmentPool::global().invalidate(uri);
+        PluginRegistryCache::global().invalidate(uri);
         static auto &logger = Poco::Logger::get("PothosFlow.BlockCache");
         logger.warning("Failed to query JSON Docs from %s - %s", uri.toStdString(), ex.displayText());
     }
@@ -39,6 +197,68 @@ static QJsonArray queryBlockDescs(const QString &uri)
     return QJsonArray(); //empty JSON array
 }
 
+/***********************************************************************
+ * Query a single JSON doc from node
+ **********************************************************************/
+static QJsonObject queryBlockDescAt(const QString &uri, const QString &path)
+{
+    try
+    {
+        auto env = RemoteEnvironmentPool::global().getEnvironment(uri, QUERY_TIMEOUT_MS*1000);
+        auto DocUtils = env->findProxy("Pothos/Util/DocUtils");
+        const std::string json = DocUtils.call("dumpJsonAt", path.toStdString());
+        QJsonParseError errorParser;
+        const auto jsonDoc = QJsonDocument::fromJson(QByteArray(json.data(), json.size()), &errorParser);
+        if (jsonDoc.isNull()) throw Pothos::Exception(errorParser.errorString().toStdString());
+        return jsonDoc.object();
+    }
+    catch (const Pothos::Exception &)
+    {
+        //pass
+    }
+
+    return QJsonObject();
+}
+
+/*!
+ * The results of a block description search over all nodes.
+ * Shared with the queries because they may outlive the search.
+ */
+struct BlockDescSearch
+{
+    BlockDescSearch(const size_t numNodes):
+        results(numNodes),
+        finished(numNodes, false)
+    {
+        return;
+    }
+
+    //! True when the first result in host order is known
+    bool isDecided(void) const
+    {
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            if (not finished[i]) return false;
+            if (not results[i].isEmpty()) return true;
+        }
+        return true;
+    }
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<QJsonObject> results;
+    std::vector<bool> finished;
+};
+
+static void searchBlockDescAt(std::shared_ptr<BlockDescSearch> search, const size_t index, const QString &uri, const QString &path)
+{
+    const auto result = queryBlockDescAt(uri, path);
+    std::lock_guard<std::mutex> lock(search->mutex);
+    search->results[index] = result;
+    search->finished[index] = true;
+    search->cond.notify_all();
+}
+
 /***********************************************************************
  * Block Cache impl
  **********************************************************************/
@@ -53,13 +273,15 @@ BlockCache::BlockCache(QObject *parent, HostExplorerDock *hostExplorer):
     QObject(parent),
     _hostExplorerDock(hostExplorer),
     _watcher(new QFutureWatcher<QJsonArray>(this)),
+    _queryPool(new QThreadPool(this)),
     _mapMutex(new QReadWriteLock())
 {
     globalBlockCache = this;
+    _missTimer.start();
     assert(_hostExplorerDock != nullptr);
     connect(_watcher, &QFutureWatcher<QJsonArray>::resultReadyAt, this, &BlockCache::handleWatcherDone);
     connect(_watcher, &QFutureWatcher<QJsonArray>::finished, this, &BlockCache::handleWatcherFinished);
-    connect(_hostExplorerDock, &HostExplorerDock::hostUriListChanged, this, &BlockCache::update);
+    connect(_hostExplorerDock, &HostExplorerDock::hostUriListChanged, this, &BlockCache::handleHostUriListChanged);
 }
 
 BlockCache::~BlockCache(void)
@@ -74,91 +296,167 @@ QJsonObject BlockCache::getBlockDescFromPath(const QString &path)
         QReadLocker lock(_mapMutex);
         auto it = _pathToBlockDesc.find(path);
         if (it != _pathToBlockDesc.end()) return it->second;
+
+        //this path was recently searched for and not found
+        auto missIt = _pathMissExpiry.find(path);
+        if (missIt != _pathMissExpiry.end() and missIt->second > _missTimer.elapsed()) return QJsonObject();
     }
 
-    //search all of the nodes
-    for (const auto &uri : _hostExplorerDock->hostUriList())
+    //search all of the nodes in parallel,
+    //abandoned queries complete in the query thread pool
+    const auto uris = _hostExplorerDock->hostUriList();
+    std::shared_ptr<BlockDescSearch> search(new BlockDescSearch(uris.size()));
+    for (int i = 0; i < uris.size(); i++)
+    {
+        QtConcurrent::run(_queryPool, std::bind(&searchBlockDescAt, search, size_t(i), uris.at(i), path));
+    }
+
+    //wait for the first node in host order with a result,
+    //or take the first result of the nodes that finished in time
+    QJsonObject blockDesc;
+    bool allFinished = true;
     {
-        try
+        std::unique_lock<std::mutex> lock(search->mutex);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(QUERY_TIMEOUT_MS);
+        while (not search->isDecided())
         {
-            auto client = Pothos::RemoteClient(uri.toStdString());
-            auto env = client.makeEnvironment("managed");
-            auto DocUtils = env->findProxy("Pothos/Util/DocUtils");
-            const std::string json = DocUtils.call("dumpJsonAt", path.toStdString());
-            QJsonParseError errorParser;
-            const auto jsonDoc = QJsonDocument::fromJson(QByteArray(json.data(), json.size()), &errorParser);
-            if (jsonDoc.isNull()) throw Pothos::Exception(errorParser.errorString().toStdString());
-            return jsonDoc.object();
+            if (search->cond.wait_until(lock, deadline) == std::cv_status::timeout) break;
         }
-        catch (const Pothos::Exception &)
+        for (size_t i = 0; i < search->results.size(); i++)
         {
-            //pass
+            if (not search->finished[i]) allFinished = false;
+            else if (not search->results[i].isEmpty()) {blockDesc = search->results[i]; break;}
         }
     }
 
-    return QJsonObject();
+    //only remember a miss when every node answered without it
+    QWriteLocker lock(_mapMutex);
+    if (not blockDesc.isEmpty()) _pathToBlockDesc[path] = blockDesc;
+    else if (allFinished) _pathMissExpiry[path] = _missTimer.elapsed() + MISS_CACHE_TTL_MS;
+    return blockDesc;
 }
 
 void BlockCache::clear(void)
 {
     QWriteLocker lock(_mapMutex);
     _pathToBlockDesc.clear();
+    _pathMissExpiry.clear();
+
+    //reload queries every host again rather than trust the on-disk cache
+    QDir(QFileInfo(getBlockCacheFilePath("")).absolutePath()).removeRecursively();
 }
 
 void BlockCache::update(void)
 {
     MainSplash::global()->postMessage(tr("Updating block cache..."));
+    this->refreshHosts(_hostExplorerDock->hostUriList());
+}
 
-    //cancel the existing future, begin a new one
-    //if (_watcher->isRunning()) return;
-    _watcher->cancel();
-    _watcher->waitForFinished();
+void BlockCache::handleHostUriListChanged(void)
+{
+    //only query the hosts that were just added
+    QStringList newUris;
+    for (const auto &uri : _hostExplorerDock->hostUriList())
+    {
+        if (_uriToBlockDescs.count(uri) == 0) newUris.push_back(uri);
+    }
+    this->refreshHosts(newUris);
+}
 
-    //nodeKeys cannot be a temporary because QtConcurrent will reference them
-    _allRemoteNodeUris = _hostExplorerDock->hostUriList();
-    _watcher->setFuture(QtConcurrent::mapped(_allRemoteNodeUris, &queryBlockDescs));
+void BlockCache::refreshHosts(const QStringList &uris)
+{
+    //cancel the existing future, the unfinished hosts are queried again below
+    QStringList queryUris(uris);
+    if (_watcher->isRunning())
+    {
+        _watcher->cancel();
+        _watcher->waitForFinished();
+        for (const auto &uri : _queryUris)
+        {
+            if (not queryUris.contains(uri)) queryUris.push_back(uri);
+        }
+    }
+
+    //forget the hosts that were removed from the host list
+    const auto hostUris = _hostExplorerDock->hostUriList();
+    std::map<QString, QJsonArray> newMap;
+    for (const auto &uri : hostUris)
+    {
+        auto it = _uriToBlockDescs.find(uri);
+        if (it != _uriToBlockDescs.end()) newMap[uri] = it->second;
+
+        //populate instantly from the on-disk cache while the host is revalidated
+        else newMap[uri] = loadBlockCacheFile(uri)["blockDescs"].toArray();
+    }
+    _uriToBlockDescs = newMap;
+    this->applyBlockDescs();
+
+    //queryUris cannot be a temporary because QtConcurrent will reference them
+    _queryUris.clear();
+    for (const auto &uri : queryUris)
+    {
+        if (hostUris.contains(uri)) _queryUris.push_back(uri);
+    }
+    _watcher->setFuture(QtConcurrent::mapped(_queryUris, &queryBlockDescs));
 }
 
 void BlockCache::handleWatcherFinished(void)
 {
     MainSplash::global()->postMessage(tr("Block cache updated."));
+    emit this->blockDescReady();
 
-    //remove old nodes
-    std::map<QString, QJsonArray> newMap;
-    for (const auto &uri : _allRemoteNodeUris) newMap[uri] = _uriToBlockDescs[uri];
-    _uriToBlockDescs = newMap;
+    static auto &logger = Poco::Logger::get("PothosFlow.BlockCache");
+    const auto stats = RemoteEnvironmentPool::global().getStats();
+    logger.debug("Environment pool: %z hits, %z misses, %z evictions, %z entries",
+        stats.hits, stats.misses, stats.evictions, stats.entries);
+}
 
+void BlockCache::handleWatcherDone(const int which)
+{
+    //apply each host as it completes, ignore hosts removed in the meantime
+    const auto &uri = _queryUris[which];
+    if (_uriToBlockDescs.count(uri) == 0) return;
+    _uriToBlockDescs[uri] = _watcher->resultAt(which);
+    this->applyBlockDescs();
+}
+
+void BlockCache::applyBlockDescs(void)
+{
     //map paths to block descs
+    std::map<QString, QJsonObject> pathToBlockDesc;
+    for (const auto &pair : _uriToBlockDescs)
     {
-        QWriteLocker lock(_mapMutex);
-        _pathToBlockDesc.clear();
-        for (const auto &pair : _uriToBlockDescs)
+        for (const auto &blockDescVal : pair.second)
         {
-            for (const auto &blockDescVal : pair.second)
-            {
-                const auto blockDesc = blockDescVal.toObject();
-                const auto path = blockDesc["path"].toString();
-                _pathToBlockDesc[path] = blockDesc;
-            }
+            const auto blockDesc = blockDescVal.toObject();
+            const auto path = blockDesc["path"].toString();
+            pathToBlockDesc[path] = blockDesc;
         }
     }
 
-    //make a master block desc list
-    QJsonArray superSetBlockDescs;
+    //diff against the descs that the subscribers already have
+    QJsonArray addedBlockDescs, changedBlockDescs;
+    QStringList removedPaths;
+    for (const auto &pair : pathToBlockDesc)
     {
-        QReadLocker lock(_mapMutex);
-        for (const auto &pair : _pathToBlockDesc)
-        {
-            superSetBlockDescs.push_back(pair.second);
-        }
+        auto it = _mergedBlockDescs.find(pair.first);
+        if (it == _mergedBlockDescs.end()) addedBlockDescs.push_back(pair.second);
+        else if (it->second != pair.second) changedBlockDescs.push_back(pair.second);
+    }
+    for (const auto &pair : _mergedBlockDescs)
+    {
+        if (pathToBlockDesc.count(pair.first) == 0) removedPaths.push_back(pair.first);
     }
 
-    //let the subscribers know
-    emit this->blockDescReady();
-    emit this->blockDescUpdate(superSetBlockDescs);
-}
+    {
+        QWriteLocker lock(_mapMutex);
+        _pathToBlockDesc = pathToBlockDesc;
+        _pathMissExpiry.clear(); //the new descs may resolve past misses
+    }
+    _mergedBlockDescs = pathToBlockDesc;
 
-void BlockCache::handleWatcherDone(const int which)
-{
-    _uriToBlockDescs[_allRemoteNodeUris[which]] = _watcher->resultAt(which);
+    //let the subscribers know, revalidation usually matches the cache
+    if (not removedPaths.isEmpty()) emit this->blockDescsRemoved(removedPaths);
+    if (not changedBlockDescs.isEmpty()) emit this->blockDescsChanged(changedBlockDescs);
+    if (not addedBlockDescs.isEmpty()) emit this->blockDescsAdded(addedBlockDescs);
 }
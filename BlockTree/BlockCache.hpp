@@ -9,10 +9,12 @@
 #include <QFutureWatcher>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QElapsedTimer>
 #include <map>
 
 class HostExplorerDock;
 class QReadWriteLock;
+class QThreadPool;
 
 class BlockCache : public QObject
 {
@@ -26,29 +28,57 @@ public:
 
     ~BlockCache(void);
 
-    //! Get a block description given the block registry path
+    /*!
+     * Get a block description given the block registry path.
+     * Paths missing from the cache are searched for on all nodes in parallel;
+     * the result is cached, and misses are remembered for a short time.
+     */
     QJsonObject getBlockDescFromPath(const QString &path);
 
 signals:
-    void blockDescUpdate(const QJsonArray &);
+    //! New block descriptions became available
+    void blockDescsAdded(const QJsonArray &);
+
+    //! Existing block descriptions changed in content
+    void blockDescsChanged(const QJsonArray &);
+
+    //! Block descriptions for these paths are no longer available
+    void blockDescsRemoved(const QStringList &);
+
     void blockDescReady(void);
 
 public slots:
     void clear(void);
+
+    //! Refresh the block descriptions of all hosts
     void update(void);
 
 private slots:
+    void handleHostUriListChanged(void);
+
     void handleWatcherFinished(void);
 
     void handleWatcherDone(const int which);
 
 private:
+    //! Query the block descriptions of these hosts in the background
+    void refreshHosts(const QStringList &uris);
+
+    //! Rebuild the path lookup and notify subscribers of the differences
+    void applyBlockDescs(void);
+
     HostExplorerDock *_hostExplorerDock;
-    QStringList _allRemoteNodeUris;
+    QStringList _queryUris;
     QFutureWatcher<QJsonArray> *_watcher;
 
+    //! Dedicated pool for path searches, which may be abandoned on slow nodes
+    QThreadPool *_queryPool;
+
     //storage structures
     QReadWriteLock *_mapMutex;
     std::map<QString, QJsonArray> _uriToBlockDescs;
     std::map<QString, QJsonObject> _pathToBlockDesc;
+    std::map<QString, QJsonObject> _mergedBlockDescs;
+    QElapsedTimer _missTimer;
+    std::map<QString, qint64> _pathMissExpiry;
 };
@@ -0,0 +1,240 @@
+// Copyright (c) 2014-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "BlockTree/BlockSearchIndex.hpp"
+#include <QJsonArray>
+#include <QJsonValue>
+#include <algorithm> //min/max/sort
+#include <cstdlib> //abs
+
+//! How much a match in each field counts toward the score
+static const double NAME_WEIGHT = 4.0;
+static const double KEYWORD_WEIGHT = 3.0;
+static const double CATEGORY_WEIGHT = 2.0;
+static const double PATH_WEIGHT = 2.0;
+static const double DOCS_WEIGHT = 1.0;
+
+//! How much each kind of token match counts toward the score
+static const double EXACT_QUALITY = 1.0;
+static const double PREFIX_QUALITY = 0.75;
+static const double SUBSTRING_QUALITY = 0.5;
+static const double FUZZY_QUALITY = 0.25;
+
+/***********************************************************************
+ * token helpers
+ **********************************************************************/
+static std::vector<uint64_t> makeTrigrams(const QString &token)
+{
+    std::vector<uint64_t> trigrams;
+    for (int i = 0; i+2 < token.size(); i++)
+    {
+        trigrams.push_back(
+            (uint64_t(token[i].unicode()) << 32) |
+            (uint64_t(token[i+1].unicode()) << 16) |
+            (uint64_t(token[i+2].unicode()) << 0));
+    }
+    return trigrams;
+}
+
+//! Levenshtein distance that gives up once the distance exceeds maxDist
+static int boundedEditDistance(const QString &a, const QString &b, const int maxDist)
+{
+    if (std::abs(a.size() - b.size()) > maxDist) return maxDist+1;
+    std::vector<int> prev(b.size()+1), curr(b.size()+1);
+    for (int j = 0; j <= b.size(); j++) prev[j] = j;
+    for (int i = 1; i <= a.size(); i++)
+    {
+        curr[0] = i;
+        int rowMin = curr[0];
+        for (int j = 1; j <= b.size(); j++)
+        {
+            const int cost = (a[i-1] == b[j-1])?0:1;
+            curr[j] = std::min(std::min(prev[j]+1, curr[j-1]+1), prev[j-1]+cost);
+            rowMin = std::min(rowMin, curr[j]);
+        }
+        if (rowMin > maxDist) return maxDist+1;
+        std::swap(prev, curr);
+    }
+    return prev[b.size()];
+}
+
+QStringList BlockSearchIndex::tokenize(const QString &text)
+{
+    QStringList tokens;
+    QString token;
+    for (const auto &ch : text)
+    {
+        if (ch.isLetterOrNumber()) token += ch.toLower();
+        else if (not token.isEmpty())
+        {
+            tokens.push_back(token);
+            token.clear();
+        }
+    }
+    if (not token.isEmpty()) tokens.push_back(token);
+    return tokens;
+}
+
+/***********************************************************************
+ * index maintenance
+ **********************************************************************/
+BlockSearchIndex::BlockSearchIndex(void)
+{
+    return;
+}
+
+void BlockSearchIndex::insert(const QJsonObject &blockDesc)
+{
+    const auto path = blockDesc["path"].toString();
+    this->remove(path);
+
+    const auto indexText = [this, &path](const QString &text, const double weight)
+    {
+        for (const auto &token : tokenize(text)) this->indexToken(path, token, weight);
+    };
+    indexText(blockDesc["name"].toString(), NAME_WEIGHT);
+    indexText(path, PATH_WEIGHT);
+    for (const auto &categoryVal : blockDesc["categories"].toArray())
+    {
+        indexText(categoryVal.toString(), CATEGORY_WEIGHT);
+    }
+    for (const auto &keywordVal : blockDesc["keywords"].toArray())
+    {
+        indexText(keywordVal.toString(), KEYWORD_WEIGHT);
+    }
+    for (const auto &lineVal : blockDesc["docs"].toArray())
+    {
+        indexText(lineVal.toString(), DOCS_WEIGHT);
+    }
+}
+
+void BlockSearchIndex::remove(const QString &path)
+{
+    auto it = _pathToTokens.find(path);
+    if (it == _pathToTokens.end()) return;
+    for (const auto &token : it->second) this->unindexToken(path, token);
+    _pathToTokens.erase(it);
+}
+
+void BlockSearchIndex::clear(void)
+{
+    _tokens.clear();
+    _trigramToTokens.clear();
+    _pathToTokens.clear();
+}
+
+void BlockSearchIndex::indexToken(const QString &path, const QString &token, const double weight)
+{
+    auto it = _tokens.find(token);
+    if (it == _tokens.end())
+    {
+        it = _tokens.emplace(token, TokenEntry()).first;
+        for (const auto &trigram : makeTrigrams(token)) _trigramToTokens[trigram].insert(token);
+    }
+    auto &bestWeight = it->second.weights[path];
+    bestWeight = std::max(bestWeight, weight);
+    _pathToTokens[path].insert(token);
+}
+
+void BlockSearchIndex::unindexToken(const QString &path, const QString &token)
+{
+    auto it = _tokens.find(token);
+    if (it == _tokens.end()) return;
+    it->second.weights.erase(path);
+    if (not it->second.weights.empty()) return;
+
+    //last block with this token, drop it from the trigram index
+    for (const auto &trigram : makeTrigrams(token))
+    {
+        auto triIt = _trigramToTokens.find(trigram);
+        if (triIt == _trigramToTokens.end()) continue;
+        triIt->second.erase(token);
+        if (triIt->second.empty()) _trigramToTokens.erase(triIt);
+    }
+    _tokens.erase(it);
+}
+
+/***********************************************************************
+ * index search
+ **********************************************************************/
+void BlockSearchIndex::matchWord(const QString &word, std::map<QString, double> &scores) const
+{
+    const auto scoreToken = [this, &scores](const QString &token, const double quality)
+    {
+        const auto it = _tokens.find(token);
+        if (it == _tokens.end()) return;
+        for (const auto &pair : it->second.weights)
+        {
+            auto &score = scores[pair.first];
+            score = std::max(score, pair.second*quality);
+        }
+    };
+
+    //exact and prefix matches are a range of the sorted tokens
+    for (auto it = _tokens.lower_bound(word); it != _tokens.end() and it->first.startsWith(word); ++it)
+    {
+        scoreToken(it->first, (it->first == word)?EXACT_QUALITY:PREFIX_QUALITY);
+    }
+
+    //short words have no trigrams, prefix matching only
+    const auto trigrams = makeTrigrams(word);
+    if (trigrams.empty()) return;
+
+    //count the shared trigrams of every candidate token
+    std::map<QString, size_t> sharedCounts;
+    for (const auto &trigram : trigrams)
+    {
+        const auto triIt = _trigramToTokens.find(trigram);
+        if (triIt == _trigramToTokens.end()) continue;
+        for (const auto &token : triIt->second) sharedCounts[token]++;
+    }
+
+    //a single edit destroys at most three trigrams
+    const int maxEdits = (word.size() >= 8)?2:((word.size() >= 4)?1:0);
+    const size_t minShared = (trigrams.size() > size_t(3*maxEdits))?(trigrams.size() - 3*maxEdits):1;
+    for (const auto &pair : sharedCounts)
+    {
+        const auto &token = pair.first;
+        if (token.startsWith(word)) continue; //already scored
+        if (pair.second == trigrams.size() and token.contains(word)) scoreToken(token, SUBSTRING_QUALITY);
+        else if (maxEdits > 0 and pair.second >= minShared and
+            boundedEditDistance(word, token, maxEdits) <= maxEdits) scoreToken(token, FUZZY_QUALITY);
+    }
+}
+
+std::vector<std::pair<QString, double>> BlockSearchIndex::search(const QString &query) const
+{
+    std::vector<std::pair<QString, double>> results;
+    const auto words = tokenize(query);
+    if (words.isEmpty()) return results;
+
+    //every word must match, the scores of the words add up
+    std::map<QString, double> totals;
+    for (int i = 0; i < words.size(); i++)
+    {
+        std::map<QString, double> scores;
+        this->matchWord(words[i], scores);
+        if (i == 0)
+        {
+            totals = scores;
+            continue;
+        }
+
+        std::map<QString, double> intersection;
+        for (const auto &pair : totals)
+        {
+            const auto it = scores.find(pair.first);
+            if (it != scores.end()) intersection[pair.first] = pair.second + it->second;
+        }
+        totals = intersection;
+        if (totals.empty()) break;
+    }
+
+    results.assign(totals.begin(), totals.end());
+    std::stable_sort(results.begin(), results.end(),
+        [](const std::pair<QString, double> &a, const std::pair<QString, double> &b)
+        {
+            return a.second > b.second;
+        });
+    return results;
+}
@@ -0,0 +1,65 @@
+// Copyright (c) 2014-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <map>
+#include <set>
+
+/*!
+ * A search index over the block descriptions of the block tree.
+ * The name, path, categories, keywords, and docs of each block
+ * are split into lower case tokens. The tokens are indexed
+ * by their trigrams for fast substring and fuzzy lookups.
+ *
+ * Every word of a query must match a token of the block,
+ * exactly, by prefix, by substring, or within a small edit distance.
+ * The score of a block sums the quality of each word's best match
+ * weighted by the field it matched in (a name beats the docs).
+ */
+class BlockSearchIndex
+{
+public:
+    BlockSearchIndex(void);
+
+    //! Add or replace a block description keyed by its path
+    void insert(const QJsonObject &blockDesc);
+
+    //! Remove a block description by its path
+    void remove(const QString &path);
+
+    //! Remove all block descriptions
+    void clear(void);
+
+    /*!
+     * Search the index for blocks matching all query words.
+     * \param query the user's filter string
+     * \return block paths and scores sorted best match first
+     */
+    std::vector<std::pair<QString, double>> search(const QString &query) const;
+
+    //! Split text into lower case alphanumeric tokens
+    static QStringList tokenize(const QString &text);
+
+private:
+    typedef uint64_t Trigram;
+
+    struct TokenEntry
+    {
+        std::map<QString, double> weights; //path to best field weight
+    };
+
+    void indexToken(const QString &path, const QString &token, const double weight);
+    void unindexToken(const QString &path, const QString &token);
+    void matchWord(const QString &word, std::map<QString, double> &scores) const;
+
+    std::map<QString, TokenEntry> _tokens;
+    std::map<Trigram, std::set<QString>> _trigramToTokens;
+    std::map<QString, std::set<QString>> _pathToTokens;
+};
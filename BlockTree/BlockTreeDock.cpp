@@ -39,11 +39,13 @@ BlockTreeDock::BlockTreeDock(QWidget *parent, BlockCache *blockCache, GraphEdito
     layout->addWidget(_searchBox);
 
     _blockTree = new BlockTreeWidget(this->widget(), editorTabs);
-    connect(blockCache, SIGNAL(blockDescUpdate(const QJsonArray &)),
-        _blockTree, SLOT(handleBlockDescUpdate(const QJsonArray &)));
+    connect(blockCache, &BlockCache::blockDescsAdded, _blockTree, &BlockTreeWidget::handleBlockDescsAdded);
+    connect(blockCache, &BlockCache::blockDescsChanged, _blockTree, &BlockTreeWidget::handleBlockDescsChanged);
+    connect(blockCache, &BlockCache::blockDescsRemoved, _blockTree, &BlockTreeWidget::handleBlockDescsRemoved);
     connect(_blockTree, SIGNAL(blockDescEvent(const QJsonObject &, bool)),
         this, SLOT(handleBlockDescEvent(const QJsonObject &, bool)));
     connect(_searchBox, &QLineEdit::textChanged, _blockTree, &BlockTreeWidget::handleFilter);
+    connect(_searchBox, &QLineEdit::returnPressed, _blockTree, &BlockTreeWidget::selectBestMatch);
     layout->addWidget(_blockTree);
 
     _addButton = new QPushButton(makeIconFromTheme("list-add"), "Add Block", this->widget());
@@ -8,6 +8,7 @@
 #include "GraphEditor/GraphEditorTabs.hpp"
 #include "GraphEditor/GraphEditor.hpp"
 #include "GraphEditor/GraphDraw.hpp"
+#include "MainWindow/MainActions.hpp"
 #include <QTreeWidgetItem>
 #include <QApplication>
 #include <QDrag>
@@ -15,15 +16,23 @@
 #include <QMimeData>
 #include <QTimer>
 #include <QPainter>
+#include <QAction>
 #include <QJsonDocument>
 #include <memory>
 
 static const long UPDATE_TIMER_MS = 500;
 
+//! Idle time between rendering the previews of expanded categories
+static const long PREVIEW_TIMER_MS = 10;
+
+//! Flush the preview cache when it grows past this many pixmaps
+static const size_t PREVIEW_CACHE_MAX_ENTRIES = 512;
+
 BlockTreeWidget::BlockTreeWidget(QWidget *parent, GraphEditorTabs *editorTabs):
     QTreeWidget(parent),
     _editorTabs(editorTabs),
     _filttimer(new QTimer(this)),
+    _previewTimer(new QTimer(this)),
     _dragItem(nullptr)
 {
     QStringList columnNames;
@@ -33,10 +42,24 @@ BlockTreeWidget::BlockTreeWidget(QWidget *parent, GraphEditorTabs *editorTabs):
 
     _filttimer->setSingleShot(true);
     _filttimer->setInterval(UPDATE_TIMER_MS);
+    _previewTimer->setInterval(PREVIEW_TIMER_MS);
 
     connect(this, &BlockTreeWidget::itemSelectionChanged, this, &BlockTreeWidget::handleSelectionChange);
     connect(this, SIGNAL(itemDoubleClicked(QTreeWidgetItem *, int)), this, SLOT(handleItemDoubleClicked(QTreeWidgetItem *, int)));
     connect(_filttimer, &QTimer::timeout, this, &BlockTreeWidget::handleFilterTimerExpired);
+    connect(this, &BlockTreeWidget::itemExpanded, this, &BlockTreeWidget::handleItemExpanded);
+    connect(_previewTimer, &QTimer::timeout, this, &BlockTreeWidget::handlePreviewTimer);
+
+    //the previews are keyed by zoom, which covers the low detail threshold,
+    //but the port display modes change the rendering at every zoom
+    auto actions = MainActions::global();
+    connect(actions->showPortNamesAction, &QAction::changed, this, &BlockTreeWidget::handleBlockDisplayModeChange);
+    connect(actions->eventPortsInlineAction, &QAction::changed, this, &BlockTreeWidget::handleBlockDisplayModeChange);
+}
+
+void BlockTreeWidget::handleBlockDisplayModeChange(void)
+{
+    _previewCache.clear();
 }
 
 void BlockTreeWidget::mousePressEvent(QMouseEvent *event)
@@ -76,50 +99,179 @@ void BlockTreeWidget::mouseMoveEvent(QMouseEvent *event)
     auto blockItem = dynamic_cast<BlockTreeWidgetItem *>(_dragItem);
     if (blockItem->getBlockDesc().isEmpty()) return;
 
-    //create a block object to render the image
+    //render at the zoom of the destination, or reuse the cached preview
     auto draw = _editorTabs->getCurrentGraphEditor()->getCurrentGraphDraw();
+    const auto &preview = this->getBlockPreview(blockItem->getBlockDesc(), draw);
+
+    //create the drag object
+    auto mimeData = new QMimeData();
+    const QJsonDocument jsonDoc(blockItem->getBlockDesc());
+    mimeData->setData("binary/json/pothos_block", jsonDoc.toBinaryData());
+    auto drag = new QDrag(this);
+    drag->setMimeData(mimeData);
+    drag->setPixmap(preview.pixmap);
+    drag->setHotSpot(preview.hotSpot);
+    drag->exec(Qt::CopyAction | Qt::MoveAction);
+}
+
+/***********************************************************************
+ * drag previews
+ **********************************************************************/
+const BlockTreeWidget::BlockPreview &BlockTreeWidget::getBlockPreview(const QJsonObject &blockDesc, GraphDraw *draw)
+{
+    const auto zoomScale = draw->zoomScale();
+    const auto key = std::make_pair(blockDesc["path"].toString(), zoomScale);
+    auto it = _previewCache.find(key);
+    if (it != _previewCache.end()) return it->second;
+    if (_previewCache.size() >= PREVIEW_CACHE_MAX_ENTRIES) _previewCache.clear();
+
+    //create a block object to render the image
     std::unique_ptr<GraphBlock> renderBlock(new GraphBlock(draw));
-    renderBlock->setBlockDesc(blockItem->getBlockDesc());
+    renderBlock->setBlockDesc(blockDesc);
     renderBlock->prerender(); //precalculate so we can get bounds
     const auto bounds = renderBlock->boundingRect();
 
-    //draw the block's preview onto a mini pixmap
-    QPixmap pixmap(bounds.size().toSize()+QSize(2,2));
-    pixmap.fill(Qt::transparent);
-    QPainter painter(&pixmap);
-    painter.translate(-bounds.topLeft()+QPoint(1,1));
-    //painter.scale(zoomScale, zoomScale); //TODO get zoomscale from draw
+    //draw the block's preview onto a mini pixmap at the zoom of the draw
+    BlockPreview preview;
+    preview.pixmap = QPixmap((bounds.size()*zoomScale).toSize()+QSize(2,2));
+    preview.pixmap.fill(Qt::transparent);
+    QPainter painter(&preview.pixmap);
+    painter.translate(QPoint(1,1));
+    painter.scale(zoomScale, zoomScale);
+    painter.translate(-bounds.topLeft());
     painter.setRenderHint(QPainter::Antialiasing);
     painter.setRenderHint(QPainter::HighQualityAntialiasing);
     painter.setRenderHint(QPainter::SmoothPixmapTransform);
     renderBlock->render(painter);
     renderBlock.reset();
     painter.end();
+    preview.hotSpot = (-bounds.topLeft()*zoomScale).toPoint();
 
-    //create the drag object
-    auto mimeData = new QMimeData();
-    const QJsonDocument jsonDoc(blockItem->getBlockDesc());
-    mimeData->setData("binary/json/pothos_block", jsonDoc.toBinaryData());
-    auto drag = new QDrag(this);
-    drag->setMimeData(mimeData);
-    drag->setPixmap(pixmap);
-    drag->setHotSpot(-bounds.topLeft().toPoint());
-    drag->exec(Qt::CopyAction | Qt::MoveAction);
+    return _previewCache.emplace(key, preview).first->second;
+}
+
+void BlockTreeWidget::erasePreviews(const QString &path)
+{
+    auto it = _previewCache.lower_bound(std::make_pair(path, qreal(0.0)));
+    while (it != _previewCache.end() and it->first.first == path) it = _previewCache.erase(it);
+}
+
+void BlockTreeWidget::handleItemExpanded(QTreeWidgetItem *item)
+{
+    //searching expands every category, dont render the entire tree
+    if (not _filter.isEmpty()) return;
+
+    //only queue blocks that actually became visible to the user
+    for (auto parent = item->parent(); parent != nullptr; parent = parent->parent())
+    {
+        if (not parent->isExpanded()) return;
+    }
+    this->queueBlockPreviews(item);
+    if (not _previewQueue.isEmpty()) _previewTimer->start();
+}
+
+void BlockTreeWidget::queueBlockPreviews(QTreeWidgetItem *item)
+{
+    for (int i = 0; i < item->childCount(); i++)
+    {
+        const auto b = dynamic_cast<BlockTreeWidgetItem *>(item->child(i));
+        if (b == nullptr) continue;
+        if (b->childCount() != 0)
+        {
+            if (b->isExpanded()) this->queueBlockPreviews(b);
+        }
+        else if (not b->getBlockDesc().isEmpty())
+        {
+            _previewQueue.push_back(b->getBlockDesc()["path"].toString());
+        }
+    }
+}
+
+void BlockTreeWidget::handlePreviewTimer(void)
+{
+    //render one preview per timeout to keep the tree responsive
+    if (_previewQueue.isEmpty()) return _previewTimer->stop();
+    const auto path = _previewQueue.takeFirst();
+
+    auto editor = _editorTabs->getCurrentGraphEditor();
+    if (editor == nullptr) return;
+    auto it = _blockDescs.find(path);
+    if (it == _blockDescs.end()) return;
+    this->getBlockPreview(it->second, editor->getCurrentGraphDraw());
 }
 
-void BlockTreeWidget::handleBlockDescUpdate(const QJsonArray &blockDescs)
+/***********************************************************************
+ * block description updates
+ **********************************************************************/
+void BlockTreeWidget::handleBlockDescsAdded(const QJsonArray &blockDescs)
 {
-    _blockDescs = blockDescs;
-    this->populate();
+    for (const auto &blockDescVal : blockDescs)
+    {
+        const auto blockDesc = blockDescVal.toObject();
+        _blockDescs[blockDesc["path"].toString()] = blockDesc;
+        _searchIndex.insert(blockDesc);
+        this->loadBlockDesc(blockDesc);
+    }
+    this->sortByColumn(0, Qt::AscendingOrder);
     this->resizeColumnToContents(0);
+    this->applyFilter();
+}
+
+void BlockTreeWidget::handleBlockDescsChanged(const QJsonArray &blockDescs)
+{
+    //the name or categories may have changed, so replace the old items
+    for (const auto &blockDescVal : blockDescs)
+    {
+        const auto blockDesc = blockDescVal.toObject();
+        auto &oldBlockDesc = _blockDescs[blockDesc["path"].toString()];
+        this->unloadBlockDesc(oldBlockDesc);
+        this->erasePreviews(blockDesc["path"].toString());
+        oldBlockDesc = blockDesc;
+        _searchIndex.insert(blockDesc);
+        this->loadBlockDesc(blockDesc);
+    }
+    this->sortByColumn(0, Qt::AscendingOrder);
+    this->applyFilter();
+    this->updateSelection();
+}
+
+void BlockTreeWidget::handleBlockDescsRemoved(const QStringList &paths)
+{
+    for (const auto &path : paths)
+    {
+        auto it = _blockDescs.find(path);
+        if (it == _blockDescs.end()) continue;
+        this->unloadBlockDesc(it->second);
+        this->erasePreviews(path);
+        _searchIndex.remove(path);
+        _blockDescs.erase(it);
+    }
+    this->applyFilter();
+    this->updateSelection();
 }
 
 void BlockTreeWidget::handleFilterTimerExpired(void)
 {
-    this->clear();
-    _rootNodes.clear();
-    this->populate();
-    for (auto item : this->findItems("", Qt::MatchContains, 0)) item->setExpanded(not _filter.isEmpty());
+    this->applyFilter();
+
+    //expand all matches while searching, collapse the categories when cleared
+    const auto flags = _filter.isEmpty()?Qt::MatchFlags(Qt::MatchContains):(Qt::MatchContains | Qt::MatchRecursive);
+    for (auto item : this->findItems("", flags, 0))
+    {
+        if (item->childCount() != 0) item->setExpanded(not _filter.isEmpty());
+    }
+
+    //bring the best ranked match into view, the selection is left to the user
+    const auto bestItem = this->findBlockItem(this->invisibleRootItem(), _bestMatchPath);
+    if (bestItem != nullptr) this->scrollToItem(bestItem);
+}
+
+void BlockTreeWidget::selectBestMatch(void)
+{
+    const auto bestItem = this->findBlockItem(this->invisibleRootItem(), _bestMatchPath);
+    if (bestItem == nullptr) return;
+    this->setCurrentItem(bestItem);
+    this->scrollToItem(bestItem);
 }
 
 void BlockTreeWidget::handleFilter(const QString &filter)
@@ -146,51 +298,89 @@ void BlockTreeWidget::handleItemDoubleClicked(QTreeWidgetItem *item, int)
     if (b != nullptr) emit blockDescEvent(b->getBlockDesc(), true);
 }
 
-void BlockTreeWidget::populate(void)
+void BlockTreeWidget::loadBlockDesc(const QJsonObject &blockDesc)
 {
-    for (const auto &blockDescVal : _blockDescs)
+    const auto name = blockDesc["name"].toString();
+    for (const auto &categoryVal : blockDesc["categories"].toArray())
     {
-        const auto blockDesc = blockDescVal.toObject();
-        if (not this->blockDescMatchesFilter(blockDesc)) continue;
-        const auto path = blockDesc["path"].toString();
-        const auto name = blockDesc["name"].toString();
-        for (const auto &categoryVal : blockDesc["categories"].toArray())
-        {
-            const auto category = categoryVal.toString().mid(1);
-            const auto key = category.mid(0, category.indexOf('/'));
-            if (_rootNodes.find(key) == _rootNodes.end()) _rootNodes[key] = new BlockTreeWidgetItem(this, key);
-            _rootNodes[key]->load(blockDesc, category + "/" + name);
-        }
+        const auto category = categoryVal.toString().mid(1);
+        const auto key = category.mid(0, category.indexOf('/'));
+        if (_rootNodes.find(key) == _rootNodes.end()) _rootNodes[key] = new BlockTreeWidgetItem(this, key);
+        _rootNodes[key]->load(blockDesc, category + "/" + name);
     }
+}
 
-    //sort the columns alphabetically
-    this->sortByColumn(0, Qt::AscendingOrder);
+void BlockTreeWidget::unloadBlockDesc(const QJsonObject &blockDesc)
+{
+    _dragItem = nullptr; //may be deleted below
 
-    emit this->blockDescEvent(QJsonObject(), false); //unselect
+    const auto name = blockDesc["name"].toString();
+    for (const auto &categoryVal : blockDesc["categories"].toArray())
+    {
+        const auto category = categoryVal.toString().mid(1);
+        const auto key = category.mid(0, category.indexOf('/'));
+        auto it = _rootNodes.find(key);
+        if (it == _rootNodes.end()) continue;
+        it->second->unload(category + "/" + name);
+        if (it->second->childCount() != 0) continue;
+        delete it->second;
+        _rootNodes.erase(it);
+    }
 }
 
-bool BlockTreeWidget::blockDescMatchesFilter(const QJsonObject &blockDesc)
+void BlockTreeWidget::updateSelection(void)
 {
-    if (_filter.isEmpty()) return true;
+    if (this->selectedItems().isEmpty()) emit this->blockDescEvent(QJsonObject(), false); //unselect
+    else this->handleSelectionChange();
+}
 
-    const auto path = blockDesc["path"].toString();
-    const auto name = blockDesc["name"].toString();
+void BlockTreeWidget::applyFilter(void)
+{
+    //rank the matches with the search index
+    _filterMatches.clear();
+    _bestMatchPath.clear();
+    if (not _filter.isEmpty())
+    {
+        const auto results = _searchIndex.search(_filter);
+        for (const auto &result : results) _filterMatches.insert(result.first);
+        if (not results.empty()) _bestMatchPath = results.front().first;
+    }
 
-    //construct a candidate string from path, name, categories, and keywords.
-    QString candidate = path+name;
-    for (const auto &categoryVal : blockDesc["categories"].toArray())
+    //toggle visibility rather than rebuilding the tree
+    for (int i = 0; i < this->topLevelItemCount(); i++)
+    {
+        this->applyFilter(this->topLevelItem(i));
+    }
+}
+
+bool BlockTreeWidget::applyFilter(QTreeWidgetItem *item)
+{
+    bool visible = false;
+    if (item->childCount() == 0)
     {
-        candidate += categoryVal.toString();
+        const auto b = dynamic_cast<BlockTreeWidgetItem *>(item);
+        const auto path = (b == nullptr)?QString():b->getBlockDesc()["path"].toString();
+        visible = _filter.isEmpty() or _filterMatches.count(path) != 0;
     }
-    for (const auto &keywordVal : blockDesc["keywords"].toArray())
+    for (int i = 0; i < item->childCount(); i++)
     {
-        candidate += keywordVal.toString();
+        if (this->applyFilter(item->child(i))) visible = true;
     }
+    item->setHidden(not visible);
+    return visible;
+}
 
-    //reject if filter string not found in candidate
-    candidate = candidate.toLower();
-    const auto searchToken = _filter.toLower();
-    return (candidate.indexOf(searchToken) != -1);
+QTreeWidgetItem *BlockTreeWidget::findBlockItem(QTreeWidgetItem *item, const QString &path) const
+{
+    for (int i = 0; i < item->childCount(); i++)
+    {
+        auto child = item->child(i);
+        const auto b = dynamic_cast<BlockTreeWidgetItem *>(child);
+        if (b != nullptr and child->childCount() == 0 and b->getBlockDesc()["path"].toString() == path) return child;
+        auto found = this->findBlockItem(child, path);
+        if (found != nullptr) return found;
+    }
+    return nullptr;
 }
 
 QMimeData *BlockTreeWidget::mimeData(const QList<QTreeWidgetItem *> items) const
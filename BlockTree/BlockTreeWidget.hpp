@@ -3,17 +3,24 @@
 
 #pragma once
 #include <Pothos/Config.hpp>
+#include "BlockTree/BlockSearchIndex.hpp"
 #include <QTreeWidget>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QString>
+#include <QStringList>
 #include <QList>
+#include <QPixmap>
+#include <QPoint>
+#include <utility>
 #include <map>
+#include <set>
 
 class QTimer;
 class QMimeData;
 class BlockTreeWidgetItem;
 class GraphEditorTabs;
+class GraphDraw;
 
 //! The tree widget part of the block tree top window
 class BlockTreeWidget : public QTreeWidget
@@ -27,10 +34,17 @@ signals:
     void blockDescEvent(const QJsonObject &, bool);
 
 public slots:
-    void handleBlockDescUpdate(const QJsonArray &blockDescs);
+    void handleBlockDescsAdded(const QJsonArray &blockDescs);
+
+    void handleBlockDescsChanged(const QJsonArray &blockDescs);
+
+    void handleBlockDescsRemoved(const QStringList &paths);
 
     void handleFilter(const QString &filter);
 
+    //! Select the best ranked match of the filter
+    void selectBestMatch(void);
+
 private slots:
     void handleFilterTimerExpired(void);
 
@@ -38,23 +52,60 @@ private slots:
 
     void handleItemDoubleClicked(QTreeWidgetItem *item, int);
 
+    void handleItemExpanded(QTreeWidgetItem *item);
+
+    void handlePreviewTimer(void);
+
+    void handleBlockDisplayModeChange(void);
+
 private:
 
     void mousePressEvent(QMouseEvent *event);
 
     void mouseMoveEvent(QMouseEvent *event);
 
-    void populate(void);
+    //! A rendered drag preview of a block at a particular zoom
+    struct BlockPreview
+    {
+        QPixmap pixmap;
+        QPoint hotSpot;
+    };
+
+    //! Get the cached drag preview or render it at the zoom of the draw
+    const BlockPreview &getBlockPreview(const QJsonObject &blockDesc, GraphDraw *draw);
+
+    //! Discard the previews of a block at all zoom scales
+    void erasePreviews(const QString &path);
+
+    //! Queue the visible blocks under an expanded item for rendering
+    void queueBlockPreviews(QTreeWidgetItem *item);
+
+    //! Add or remove the tree items for a block in all of its categories
+    void loadBlockDesc(const QJsonObject &blockDesc);
+    void unloadBlockDesc(const QJsonObject &blockDesc);
+
+    //! Update the selection after items were changed in place
+    void updateSelection(void);
+
+    //! Rank the blocks against the filter and hide the items that do not match
+    void applyFilter(void);
+    bool applyFilter(QTreeWidgetItem *item);
 
-    bool blockDescMatchesFilter(const QJsonObject &blockDesc);
+    QTreeWidgetItem *findBlockItem(QTreeWidgetItem *item, const QString &path) const;
 
     QMimeData *mimeData(const QList<QTreeWidgetItem *> items) const;
 
     GraphEditorTabs *_editorTabs;
     QString _filter;
     QTimer *_filttimer;
+    QTimer *_previewTimer;
+    QStringList _previewQueue;
+    std::map<std::pair<QString, qreal>, BlockPreview> _previewCache;
     QPoint _dragStartPos;
     QTreeWidgetItem *_dragItem;
-    QJsonArray _blockDescs;
+    std::map<QString, QJsonObject> _blockDescs;
+    BlockSearchIndex _searchIndex;
+    std::set<QString> _filterMatches;
+    QString _bestMatchPath;
     std::map<QString, BlockTreeWidgetItem *> _rootNodes;
 };
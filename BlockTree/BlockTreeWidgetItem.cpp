@@ -25,6 +25,25 @@ void BlockTreeWidgetItem::load(const QJsonObject &blockDesc, const QString &cate
     }
 }
 
+void BlockTreeWidgetItem::unload(const QString &category)
+{
+    const auto slashIndex = category.indexOf('/');
+    if (slashIndex == -1)
+    {
+        _blockDesc = QJsonObject();
+        return;
+    }
+
+    const auto catRest = category.mid(slashIndex+1);
+    const auto key = catRest.mid(0, catRest.indexOf("/"));
+    auto it = _subNodes.find(key);
+    if (it == _subNodes.end()) return;
+    it->second->unload(catRest);
+    if (it->second->childCount() != 0 or not it->second->getBlockDesc().isEmpty()) return;
+    delete it->second;
+    _subNodes.erase(it);
+}
+
 //this sets a tool tip -- but only when requested
 QVariant BlockTreeWidgetItem::data(int column, int role) const
 {
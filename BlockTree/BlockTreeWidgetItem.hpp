@@ -20,6 +20,9 @@ public:
 
     void load(const QJsonObject &blockDesc, const QString &category, const size_t depth = 0);
 
+    //! Remove the block at the category path, deleting empty sub-nodes
+    void unload(const QString &category);
+
     const QJsonObject &getBlockDesc(void) const
     {
         return _blockDesc;
@@ -3,12 +3,14 @@
 
 #include "EnvironmentEval.hpp"
 #include "EvalTracer.hpp"
+#include "EnvironmentRegistry.hpp"
 #include <Pothos/Proxy.hpp>
 #include <Pothos/Remote.hpp>
 #include <Pothos/System/Logger.hpp>
 #include <Pothos/Util/Network.hpp>
 #include <Poco/URI.h>
 #include <Poco/Net/SocketAddress.h>
+#include <functional> //std::bind
 
 EnvironmentEval::EnvironmentEval(void):
     _failureState(false),
@@ -43,7 +45,7 @@ void EnvironmentEval::update(void)
         //otherwise, make a new env
         else
         {
-            _env = this->makeEnvironment();
+            _env = this->acquireEnvironment();
             auto EvalEnvironment = _env->findProxy("Pothos/Util/EvalEnvironment");
             _eval = EvalEnvironment.call("make");
             _failureState = false;
@@ -51,12 +53,16 @@ void EnvironmentEval::update(void)
     }
     catch (const Pothos::Exception &ex)
     {
+        //other designs sharing this environment should not reuse it
+        const auto hostProcKey = getHostProcFromConfig(_zoneName, _config);
+        if (_env) EnvironmentRegistry::global().invalidate(hostProcKey, _env);
+
         //dont report errors if we were already in failure mode
         if (_failureState) return;
         _failureState = true;
 
         //determine if the remote host is offline or the process just crashed
-        const auto hostUri = getHostProcFromConfig(_zoneName, _config).first;
+        const auto hostUri = hostProcKey.first;
         try
         {
             Pothos::RemoteClient client(hostUri.toStdString());
@@ -80,11 +86,21 @@ HostProcPair EnvironmentEval::getHostProcFromConfig(const QString &zoneName, con
     return HostProcPair(hostUri, processName);
 }
 
-Pothos::ProxyEnvironment::Sptr EnvironmentEval::makeEnvironment(void)
+Pothos::ProxyEnvironment::Sptr EnvironmentEval::acquireEnvironment(void)
+{
+    //the evaluator made from the environment stays private to this design
+    auto &registry = EnvironmentRegistry::global();
+    if (not registry.isEnabled()) return this->makeEnvironment(false);
+    const auto hostProcKey = getHostProcFromConfig(_zoneName, _config);
+    return registry.acquire(hostProcKey, std::bind(&EnvironmentEval::makeEnvironment, this, true));
+}
+
+Pothos::ProxyEnvironment::Sptr EnvironmentEval::makeEnvironment(const bool shared)
 {
     if (_zoneName == "gui") return Pothos::ProxyEnvironment::make("managed");
 
-    const auto hostUri = getHostProcFromConfig(_zoneName, _config).first.toStdString();
+    const auto hostProc = getHostProcFromConfig(_zoneName, _config);
+    const auto hostUri = hostProc.first.toStdString();
 
     //connect to the remote host and spawn a server
     auto serverEnv = Pothos::RemoteClient(hostUri).makeEnvironment("managed");
@@ -100,9 +116,13 @@ Pothos::ProxyEnvironment::Sptr EnvironmentEval::makeEnvironment(void)
     client.holdRef(Pothos::Object(serverHandle));
     auto env = client.makeEnvironment("managed");
 
+    //label the logs by zone, unless other designs' zones share the process
+    std::string logSource = newHostUri.getHost();
+    if (shared and not hostProc.second.isEmpty()) logSource += "/" + hostProc.second.toStdString();
+    if (not shared and not _zoneName.isEmpty()) logSource = _zoneName.toStdString();
+
     //determine log delivery address
     //FIXME syslog listener doesn't support IPv6, special precautions taken:
-    const auto logSource = (not _zoneName.isEmpty())? _zoneName.toStdString() : newHostUri.getHost();
     const auto syslogListenPort = Pothos::System::Logger::startSyslogListener();
     Poco::Net::SocketAddress serverAddr(env->getPeeringAddress(), syslogListenPort);
 
@@ -61,7 +61,8 @@ public:
     }
 
 private:
-    Pothos::ProxyEnvironment::Sptr makeEnvironment(void);
+    Pothos::ProxyEnvironment::Sptr acquireEnvironment(void);
+    Pothos::ProxyEnvironment::Sptr makeEnvironment(const bool shared);
 
     QString _zoneName;
     QJsonObject _config;
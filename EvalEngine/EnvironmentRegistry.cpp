@@ -0,0 +1,68 @@
+// Copyright (c) 2014-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "EnvironmentRegistry.hpp"
+#include <Pothos/Exception.hpp>
+
+EnvironmentRegistry &EnvironmentRegistry::global(void)
+{
+    static EnvironmentRegistry registry;
+    return registry;
+}
+
+EnvironmentRegistry::EnvironmentRegistry(void):
+    _enabled(false)
+{
+    return;
+}
+
+void EnvironmentRegistry::setEnabled(const bool enabled)
+{
+    _enabled = enabled;
+}
+
+bool EnvironmentRegistry::isEnabled(void) const
+{
+    return _enabled;
+}
+
+Pothos::ProxyEnvironment::Sptr EnvironmentRegistry::acquire(const HostProcPair &key, const Factory &factory)
+{
+    //wait on another design making this environment, then check for one in use
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto &entry = _entries[key];
+    _cond.wait(lock, [&entry]{return not entry.making;});
+    auto env = entry.env.lock();
+    if (env) return env;
+    entry.making = true;
+    lock.unlock();
+
+    //spawning the server is slow, make it outside of the lock
+    try
+    {
+        env = factory();
+    }
+    catch (const Pothos::Exception &)
+    {
+        lock.lock();
+        entry.making = false;
+        _cond.notify_all();
+        throw;
+    }
+
+    lock.lock();
+    entry.env = env;
+    entry.making = false;
+    _cond.notify_all();
+    return env;
+}
+
+void EnvironmentRegistry::invalidate(const HostProcPair &key, const Pothos::ProxyEnvironment::Sptr &env)
+{
+    //only forget the entry when it was not already replaced
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _entries.find(key);
+    if (it == _entries.end()) return;
+    if (it->second.env.lock() != env) return;
+    it->second.env.reset();
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2014-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <Pothos/Proxy/Environment.hpp>
+#include "EnvironmentEval.hpp" //HostProcPair
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <map>
+
+/*!
+ * The environment registry shares proxy environments between eval engines.
+ * When enabled, the designs in every editor tab that use the same
+ * host and process name share one server process and connection.
+ * Each design still makes its own expression evaluator, thread pools,
+ * and blocks in the shared environment, so evaluation stays isolated.
+ *
+ * The registry only holds weak references: an environment lives
+ * while at least one EnvironmentEval holds it, and the server process
+ * exits when the last design using it lets go.
+ * Registry calls are thread-safe, each eval engine has its own thread.
+ */
+class EnvironmentRegistry
+{
+public:
+    typedef std::function<Pothos::ProxyEnvironment::Sptr(void)> Factory;
+
+    //! Get access to the global registry
+    static EnvironmentRegistry &global(void);
+
+    //! Enable sharing for environments made after this call
+    void setEnabled(const bool enabled);
+
+    //! Is sharing enabled?
+    bool isEnabled(void) const;
+
+    /*!
+     * Get the shared environment for this host and process,
+     * calling the factory to make it when there is none in use.
+     * Concurrent calls for the same key wait on a single factory call.
+     * \throws Pothos::Exception when the factory throws
+     */
+    Pothos::ProxyEnvironment::Sptr acquire(const HostProcPair &key, const Factory &factory);
+
+    //! Stop sharing a failed environment, the next acquire makes a new one
+    void invalidate(const HostProcPair &key, const Pothos::ProxyEnvironment::Sptr &env);
+
+private:
+    EnvironmentRegistry(void);
+
+    struct Entry
+    {
+        Entry(void):
+            making(false){}
+        std::weak_ptr<Pothos::ProxyEnvironment> env;
+        bool making;
+    };
+
+    std::atomic<bool> _enabled;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::map<HostProcPair, Entry> _entries;
+};
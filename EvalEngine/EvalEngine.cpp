@@ -135,9 +135,10 @@ QByteArray EvalEngine::getTopologyJSONDump(const QByteArray &config)
 
 QByteArray EvalEngine::getTopologyJSONStats(void)
 {
-    QByteArray result;
-    QMetaObject::invokeMethod(_impl, "getTopologyJSONStats", Qt::BlockingQueuedConnection, Q_RETURN_ARG(QByteArray, result));
-    return result;
+    //query the topology snapshot directly, monitoring never waits on evaluation
+    std::string stats;
+    if (not _impl->tryQueryTopologyJSONStats(stats)) return QByteArray();
+    return QByteArray(stats.data(), stats.size());
 }
 
 void EvalEngine::handleAffinityZonesChanged(void)
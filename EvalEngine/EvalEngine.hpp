@@ -61,7 +61,11 @@ public slots:
     //! query the JSON dump for the active topology
     QByteArray getTopologyJSONDump(const QByteArray &config);
 
-    //! query the JSON stats for the active topology
+    /*!
+     * Query the JSON stats for the active topology.
+     * This call is thread-safe and does not go through the eval thread.
+     * A null result means the topology is inactive or being modified.
+     */
     QByteArray getTopologyJSONStats(void);
 
 private slots:
@@ -68,6 +68,27 @@ EvalEngineImpl::~EvalEngineImpl(void)
     return;
 }
 
+bool EvalEngineImpl::tryQueryTopologyJSONStats(std::string &stats)
+{
+    //the query holds the snapshot lock so that the eval thread
+    //can never leave the last reference on a monitoring thread
+    std::lock_guard<std::mutex> lock(_topologySnapshotMutex);
+    if (not _topologySnapshot) return false;
+    return _topologySnapshot->tryQueryJSONStats(stats);
+}
+
+void EvalEngineImpl::updateTopologySnapshot(void)
+{
+    //swap under the lock, but release the old evaluator
+    //outside of it so that teardown happens on this thread
+    std::shared_ptr<TopologyEval> oldSnapshot;
+    {
+        std::lock_guard<std::mutex> lock(_topologySnapshotMutex);
+        oldSnapshot = _topologySnapshot;
+        _topologySnapshot = _topologyEval;
+    }
+}
+
 void EvalEngineImpl::submitActivateTopology(const bool enable)
 {
     //make a new topology evaluator only if enabled and DNE
@@ -79,6 +100,7 @@ void EvalEngineImpl::submitActivateTopology(const bool enable)
 
     //if disabled, clear the current evaluator if present
     if (not enable) _topologyEval.reset();
+    this->updateTopologySnapshot();
 
     //call into the conditional evaluation regardless
     this->evaluate();
@@ -159,16 +181,6 @@ QByteArray EvalEngineImpl::getTopologyJSONDump(const QByteArray &configBytes)
     return QByteArray(dump.data(), dump.size());
 }
 
-QByteArray EvalEngineImpl::getTopologyJSONStats(void)
-{
-    //have to do this in case this call compressed an eval-worthy event
-    this->evaluate();
-
-    if (not _topologyEval) return QByteArray();
-    const auto stats = _topologyEval->getTopology()->queryJSONStats();
-    return QByteArray(stats.data(), stats.size());
-}
-
 void EvalEngineImpl::handleMonitorTimeout(void)
 {
     //cause periodic re-eval to deal with errors
@@ -280,6 +292,7 @@ void EvalEngineImpl::evaluate(void)
         if (_topologyEval->isFailureState())
         {
             _topologyEval.reset();
+            this->updateTopologySnapshot();
             _blockEvals.clear();
             emit this->deactivateDesign();
             //cause an immediate re-evaluation
@@ -299,6 +312,7 @@ void EvalEngineImpl::submitCleanup(void)
 
     //clear evals
     _topologyEval.reset();
+    this->updateTopologySnapshot();
     _blockEvals.clear();
     _threadPoolEvals.clear();
     _environmentEvals.clear();
@@ -9,6 +9,7 @@
 #include <QString>
 #include <QJsonObject>
 #include <memory>
+#include <mutex>
 #include <map>
 #include <set>
 
@@ -36,6 +37,12 @@ public:
 
     ~EvalEngineImpl(void);
 
+    /*!
+     * Query the stats of the active topology from any thread.
+     * This bypasses the eval queue and fails when the topology is busy.
+     */
+    bool tryQueryTopologyJSONStats(std::string &stats);
+
 signals:
 
     //! Emitted by the monitor timer to signal that this thread is not-blocked
@@ -67,9 +74,6 @@ public slots:
     //! query the JSON dump for the active topology
     QByteArray getTopologyJSONDump(const QByteArray &config);
 
-    //! query the JSON stats for the active topology
-    QByteArray getTopologyJSONStats(void);
-
     //! Cleanup and shutdown prior to destruction
     void submitCleanup(void);
 
@@ -94,6 +98,11 @@ private:
     std::map<size_t, std::shared_ptr<BlockEval>> _blockEvals;
     std::shared_ptr<TopologyEval> _topologyEval;
 
+    //publish the active topology evaluator for monitoring threads
+    void updateTopologySnapshot(void);
+    std::mutex _topologySnapshotMutex;
+    std::shared_ptr<TopologyEval> _topologySnapshot;
+
     void handleOrphanedGuiBlocks(void);
     std::set<std::shared_ptr<void>> _guiBlocks;
     std::shared_ptr<EvalEngineGuiBlockDeleter> _guiBlockDeleter;
@@ -35,6 +35,7 @@ void TopologyEval::disconnect(void)
 {
     EVAL_TRACER_FUNC();
     if (this->isFailureState()) return;
+    std::unique_lock<std::mutex> lock(_topologyMutex);
 
     const auto connsCopy = _currentConnections;
     for (const auto &conn : connsCopy)
@@ -64,7 +65,8 @@ void TopologyEval::disconnect(void)
         }
     }
 
-    //commit after changes
+    //commit after changes, commit takes the lock
+    lock.unlock();
     this->commit();
 }
 
@@ -76,6 +78,7 @@ void TopologyEval::update(void)
     const auto removedConnections = diffConnectionInfos(_currentConnections, _newConnectionInfo);
     const auto addedConnections = diffConnectionInfos(_newConnectionInfo, _currentConnections);
     if ((removedConnections.size() + addedConnections.size()) == 0) return; //nothing to do
+    std::unique_lock<std::mutex> lock(_topologyMutex);
 
     //remove connections from the topology
     for (const auto &conn : removedConnections)
@@ -143,7 +146,8 @@ void TopologyEval::update(void)
         }
     }
 
-    //commit after changes
+    //commit after changes, commit takes the lock
+    lock.unlock();
     this->commit();
 
     //stash data for the current state
@@ -154,9 +158,27 @@ void TopologyEval::update(void)
     }
 }
 
+bool TopologyEval::tryQueryJSONStats(std::string &stats)
+{
+    std::unique_lock<std::mutex> lock(_topologyMutex, std::try_to_lock);
+    if (not lock.owns_lock()) return false;
+    if (this->isFailureState()) return false;
+    try
+    {
+        stats = _topology->queryJSONStats();
+    }
+    catch (const Pothos::Exception &ex)
+    {
+        _logger.error("Failed to query stats: %s", ex.displayText());
+        return false;
+    }
+    return true;
+}
+
 void TopologyEval::commit(void)
 {
     EVAL_TRACER_FUNC();
+    std::lock_guard<std::mutex> lock(_topologyMutex);
     try
     {
         _topology->commit();
@@ -8,7 +8,10 @@
 #include <QObject>
 #include <QString>
 #include <vector>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <map>
 #include <Poco/Logger.h>
 
@@ -99,6 +102,12 @@ public:
         return _failureState;
     }
 
+    /*!
+     * Query the JSON stats from any thread without waiting.
+     * Returns false when the topology is being modified.
+     */
+    bool tryQueryJSONStats(std::string &stats);
+
 private:
     ConnectionInfos _newConnectionInfo;
     ConnectionInfos _lastConnectionInfo;
@@ -110,6 +119,9 @@ private:
     Pothos::Topology *_topology;
     ConnectionInfos _currentConnections;
 
-    bool _failureState;
+    std::atomic<bool> _failureState; //read by stats queries
     Poco::Logger &_logger;
+
+    //! Held while the topology is modified, stats queries only try-lock
+    std::mutex _topologyMutex;
 };
@@ -28,9 +28,13 @@ static const qreal GraphObjectConnLineLength = 10;
 
 static const qreal GraphDrawScrollFudge = 20;
 static const QString GraphDrawBackgroundColor = "#FCFFFF";
+static const QString GraphDrawHeatmapHotColor = "#FF3B30";
+static const qreal GraphDrawHeatmapAlphaBlend = 0.7; //max blend of the hot color at full work time
 static const qreal GraphDrawZoomStep = 0.1;
 static const qreal GraphDrawZoomMax = 1.5;
-static const qreal GraphDrawZoomMin = 0.5;
+static const qreal GraphDrawZoomMin = 0.2;
+static const qreal GraphDrawLowDetailZoom = 0.45; //hide text and simplify shapes below this scale
+static const qreal GraphDrawNoAntialiasZoom = 0.35; //disable antialiasing below this scale
 
 static const qreal GraphBlockPortTextHPad = 1.5;
 static const qreal GraphBlockPortTextVPad = 1.5;
@@ -69,6 +73,8 @@ static const QString GraphConnectionLineTextFontSize = "8pt";
 static const QString GraphConnectionDefaultColor = "#000000";
 static const QString GraphConnectionHighlightColor = "#0040FF";
 static const QString GraphConnectionDisabledColor = "#A0A0A0";
+static const QString GraphConnectionThroughputTextColor = "#B22222";
+static const qreal GraphConnectionThroughputPointSize = 7;
 
 static const QString GraphWidgetGripLabelFontSize = "6pt";
 static const QString GraphWidgetGripLabelColor = "#484848";
@@ -11,7 +11,6 @@
 #include "MainWindow/MainMenu.hpp"
 #include <QJsonDocument>
 #include <QGraphicsScene>
-#include <QGraphicsPixmapItem>
 #include <QMenu>
 #include <QPainter>
 #include <QPen>
@@ -26,14 +25,15 @@
 #include <QDropEvent>
 #include <iostream>
 #include <cassert>
-#include <limits>
 #include <algorithm> //min/max
 
 GraphDraw::GraphDraw(QWidget *parent):
     QGraphicsView(parent),
     _graphEditor(qobject_cast<GraphEditor *>(parent)),
     _zoomScale(1.0),
-    _selectionState(0)
+    _selectionState(0),
+    _showGraphConnectionPoints(false),
+    _showGraphBoundingBoxes(false)
 {
     //setup scene
     const auto size = getGraphEditor()->getSceneSize();
@@ -74,27 +74,49 @@ GraphDraw::GraphDraw(QWidget *parent):
 
 GraphDraw::~GraphDraw(void)
 {
-    return;
+    //the scene outlives this view, so stop objects from unregistering into it
+    for (const auto &pair : _pendingGraphObjects) pair.second->detachRegisteredDraw();
+    for (const auto &typePair : _graphObjectsByType)
+    {
+        for (const auto &pair : typePair.second) pair.second->detachRegisteredDraw();
+    }
 }
 
 void GraphDraw::handleGraphDebugViewChange(void)
 {
     auto actions = MainActions::global();
-    _graphConnectionPoints.reset();
-    if (actions->showGraphConnectionPointsAction->isChecked())
-    {
-        _graphConnectionPoints.reset(new QGraphicsPixmapItem());
-        this->scene()->addItem(_graphConnectionPoints.get());
-    }
+    _showGraphConnectionPoints = actions->showGraphConnectionPointsAction->isChecked();
+    _showGraphBoundingBoxes = actions->showGraphBoundingBoxesAction->isChecked();
+    this->render();
+}
+
+void GraphDraw::drawForeground(QPainter *painter, const QRectF &rect)
+{
+    QGraphicsView::drawForeground(painter, rect);
+    if (not _showGraphConnectionPoints and not _showGraphBoundingBoxes) return;
 
-    _graphBoundingBoxes.reset();
-    if (actions->showGraphBoundingBoxesAction->isChecked())
+    //only objects in the exposed region, padded for the connection point lines
+    const auto margin = GraphObjectConnLineLength + GraphObjectConnPointRadius;
+    const auto exposed = rect.adjusted(-margin, -margin, margin, margin);
+    for (auto obj : this->getGraphObjects())
     {
-        _graphBoundingBoxes.reset(new QGraphicsPixmapItem());
-        this->scene()->addItem(_graphBoundingBoxes.get());
-    }
+        if (not obj->sceneBoundingRect().intersects(exposed)) continue;
+        painter->save();
+        painter->translate(obj->pos());
+        painter->rotate(obj->rotation());
 
-    this->render();
+        //optional debug overlay for connection points
+        if (_showGraphConnectionPoints) obj->renderConnectablePoints(*painter);
+
+        //optional debug overlay for bounding boxes
+        if (_showGraphBoundingBoxes)
+        {
+            painter->setPen(QPen(Qt::red));
+            painter->setBrush(Qt::NoBrush);
+            painter->drawPath(obj->shape());
+        }
+        painter->restore();
+    }
 }
 
 void GraphDraw::dragEnterEvent(QDragEnterEvent *event)
@@ -141,6 +163,12 @@ void GraphDraw::setZoomScale(const qreal zoom)
     //perform the zoom
     _zoomScale = zoom;
     this->setTransform(QTransform()); //clear
+
+    //antialiasing is expensive and mostly invisible when zoomed out
+    const bool highQuality = zoom >= GraphDrawNoAntialiasZoom;
+    this->setRenderHint(QPainter::Antialiasing, highQuality);
+    this->setRenderHint(QPainter::HighQualityAntialiasing, highQuality);
+    this->setRenderHint(QPainter::SmoothPixmapTransform, highQuality);
     this->scale(this->zoomScale(), this->zoomScale());
     this->render();
 
@@ -153,6 +181,11 @@ void GraphDraw::setZoomScale(const qreal zoom)
     }
 }
 
+bool GraphDraw::isLowDetail(void) const
+{
+    return _zoomScale < GraphDrawLowDetailZoom;
+}
+
 void GraphDraw::showEvent(QShowEvent *event)
 {
     this->updateEnabledActions();
@@ -246,44 +279,6 @@ void GraphDraw::render(void)
         obj->setPos(oldPos);
     }
 
-    //optional debug pixmap overlay for connection points
-    if (_graphConnectionPoints)
-    {
-        QPixmap pixmap(this->sceneRect().size().toSize());
-        pixmap.fill(Qt::transparent);
-        QPainter painter(&pixmap);
-        for (auto obj : allObjs)
-        {
-            painter.save();
-            painter.translate(obj->pos());
-            painter.rotate(obj->rotation());
-            obj->renderConnectablePoints(painter);
-            painter.restore();
-        }
-        _graphConnectionPoints->setPixmap(pixmap);
-        _graphConnectionPoints->setZValue(std::numeric_limits<qreal>::max());
-    }
-
-    //optional debug pixmap overlay for bounding boxes
-    if (_graphBoundingBoxes)
-    {
-        QPixmap pixmap(this->sceneRect().size().toSize());
-        pixmap.fill(Qt::transparent);
-        QPainter painter(&pixmap);
-        for (auto obj : allObjs)
-        {
-            painter.save();
-            painter.translate(obj->pos());
-            painter.rotate(obj->rotation());
-            painter.setPen(QPen(Qt::red));
-            painter.setBrush(Qt::NoBrush);
-            painter.drawPath(obj->shape());
-            painter.restore();
-        }
-        _graphBoundingBoxes->setPixmap(pixmap);
-        _graphBoundingBoxes->setZValue(std::numeric_limits<qreal>::max());
-    }
-
     //sync the topology locked status
     const bool locked = this->getGraphEditor()->isTopologyLocked();
     for (auto obj : allObjs) obj->setLocked(locked);
@@ -10,7 +10,6 @@
 
 class GraphEditor;
 class QGraphicsItem;
-class QGraphicsPixmapItem;
 class QGraphicsLineItem;
 
 class GraphDraw : public QGraphicsView
@@ -38,6 +37,12 @@ public:
     //! Get the graph object with the specified ID or nullptr
     GraphObject *getObjectById(const QString &id, const int selectionFlags = ~0);
 
+    //! Is the ID used by any graph object in this scene
+    bool isIdInUse(const QString &id) const
+    {
+        return _graphObjectsById.count(id) != 0;
+    }
+
     GraphEditor *getGraphEditor(void) const
     {
         return _graphEditor;
@@ -52,6 +57,13 @@ public:
 
     void setZoomScale(const qreal zoom);
 
+    /*!
+     * Is the zoom scale low enough to render graph objects
+     * with reduced detail: no text and simplified shapes.
+     * The layout is unchanged so connection points stay in place.
+     */
+    bool isLowDetail(void) const;
+
     QPointF getLastContextMenuPos(void) const
     {
         return _lastContextMenuPos;
@@ -94,6 +106,7 @@ protected:
     void mouseMoveEvent(QMouseEvent *event);
     void showEvent(QShowEvent *event);
     void keyPressEvent(QKeyEvent *event);
+    void drawForeground(QPainter *painter, const QRectF &rect);
 
 private slots:
     void handleCustomContextMenuRequested(const QPoint &);
@@ -108,6 +121,25 @@ private:
     GraphConnectionEndpoint mousedEndpoint(const QPoint &);
     bool tryToMakeConnection(const GraphConnectionEndpoint &thisEp);
 
+    /*!
+     * Per-type registry of the graph objects in this scene.
+     * Objects register themselves when they enter or leave the scene,
+     * and the selection set follows their selected state changes.
+     * Object lists are keyed by UID to keep a stable creation order.
+     */
+    friend class GraphObject;
+    void registerGraphObject(GraphObject *obj);
+    void unregisterGraphObject(GraphObject *obj);
+    void updateGraphObjectSelection(GraphObject *obj);
+    void updateGraphObjectId(GraphObject *obj);
+    void classifyPendingGraphObjects(void);
+    bool isGraphObjectType(GraphObject *obj, const int selectionFlags);
+    std::map<size_t, GraphObject *> _pendingGraphObjects;
+    std::map<int, std::map<size_t, GraphObject *>> _graphObjectsByType;
+    std::map<size_t, GraphObject *> _selectedGraphObjects;
+    std::map<size_t, QString> _graphObjectIds;
+    std::map<QString, std::map<size_t, GraphObject *>> _graphObjectsById;
+
     GraphEditor *_graphEditor;
     qreal _zoomScale;
     int _selectionState;
@@ -115,8 +147,9 @@ private:
     GraphConnectionEndpoint _lastClickSelectEp;
     std::map<GraphObject *, QPointF> _preMovePositions;
 
-    std::unique_ptr<QGraphicsPixmapItem> _graphConnectionPoints;
-    std::unique_ptr<QGraphicsPixmapItem> _graphBoundingBoxes;
+    //debug overlays painted over the exposed region only
+    bool _showGraphConnectionPoints;
+    bool _showGraphBoundingBoxes;
     std::unique_ptr<QGraphicsLineItem> _connectLineItem;
     std::unique_ptr<GraphObjectImmobilizer> _connectModeImmobilizer;
 };
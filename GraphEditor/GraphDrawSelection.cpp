@@ -228,29 +228,104 @@ qreal GraphDraw::getMaxZValue(void)
 
 GraphObjectList GraphDraw::getObjectsSelected(const int selectionFlags)
 {
+    this->classifyPendingGraphObjects();
     GraphObjectList objectsSelected;
-    for (auto obj : this->getGraphObjects(selectionFlags))
+    for (const auto &pair : _selectedGraphObjects)
     {
-        if (obj->isSelected()) objectsSelected.push_back(obj);
+        if (this->isGraphObjectType(pair.second, selectionFlags)) objectsSelected.push_back(pair.second);
     }
     return objectsSelected;
 }
 
 GraphObjectList GraphDraw::getGraphObjects(const int selectionFlags)
 {
+    this->classifyPendingGraphObjects();
     GraphObjectList l;
-    for (auto child : this->items())
+    for (const auto &graphType : {GRAPH_BLOCK, GRAPH_BREAKER, GRAPH_CONNECTION, GRAPH_WIDGET})
     {
-        auto o = dynamic_cast<GraphObject *>(child);
-        if (o == nullptr) continue;
-        if (((selectionFlags & GRAPH_BLOCK) != 0) and (qobject_cast<GraphBlock *>(o) != nullptr)) l.push_back(o);
-        if (((selectionFlags & GRAPH_BREAKER) != 0) and (qobject_cast<GraphBreaker *>(o) != nullptr)) l.push_back(o);
-        if (((selectionFlags & GRAPH_CONNECTION) != 0) and (qobject_cast<GraphConnection *>(o) != nullptr)) l.push_back(o);
-        if (((selectionFlags & GRAPH_WIDGET) != 0) and (qobject_cast<GraphWidget *>(o) != nullptr)) l.push_back(o);
+        if ((selectionFlags & graphType) == 0) continue;
+        for (const auto &pair : _graphObjectsByType[graphType]) l.push_back(pair.second);
     }
     return l;
 }
 
+/***********************************************************************
+ * Graph object registry
+ **********************************************************************/
+void GraphDraw::registerGraphObject(GraphObject *obj)
+{
+    //the object may still be under construction, classify it on first query
+    _pendingGraphObjects[obj->uid()] = obj;
+    if (obj->isSelected()) _selectedGraphObjects[obj->uid()] = obj;
+    this->updateGraphObjectId(obj);
+}
+
+void GraphDraw::unregisterGraphObject(GraphObject *obj)
+{
+    const auto uid = obj->uid();
+    _pendingGraphObjects.erase(uid);
+    _selectedGraphObjects.erase(uid);
+    for (auto &pair : _graphObjectsByType) pair.second.erase(uid);
+
+    auto idIt = _graphObjectIds.find(uid);
+    if (idIt == _graphObjectIds.end()) return;
+    auto &objs = _graphObjectsById[idIt->second];
+    objs.erase(uid);
+    if (objs.empty()) _graphObjectsById.erase(idIt->second);
+    _graphObjectIds.erase(idIt);
+}
+
+void GraphDraw::updateGraphObjectSelection(GraphObject *obj)
+{
+    if (obj->isSelected()) _selectedGraphObjects[obj->uid()] = obj;
+    else _selectedGraphObjects.erase(obj->uid());
+}
+
+void GraphDraw::updateGraphObjectId(GraphObject *obj)
+{
+    const auto uid = obj->uid();
+    const auto &id = obj->getId();
+    auto idIt = _graphObjectIds.find(uid);
+    if (idIt != _graphObjectIds.end())
+    {
+        if (idIt->second == id) return;
+        auto &objs = _graphObjectsById[idIt->second];
+        objs.erase(uid);
+        if (objs.empty()) _graphObjectsById.erase(idIt->second);
+    }
+    _graphObjectIds[uid] = id;
+    _graphObjectsById[id][uid] = obj;
+}
+
+void GraphDraw::classifyPendingGraphObjects(void)
+{
+    for (auto it = _pendingGraphObjects.begin(); it != _pendingGraphObjects.end();)
+    {
+        auto o = it->second;
+        int graphType = 0;
+        if (qobject_cast<GraphBlock *>(o) != nullptr) graphType = GRAPH_BLOCK;
+        else if (qobject_cast<GraphBreaker *>(o) != nullptr) graphType = GRAPH_BREAKER;
+        else if (qobject_cast<GraphConnection *>(o) != nullptr) graphType = GRAPH_CONNECTION;
+        else if (qobject_cast<GraphWidget *>(o) != nullptr) graphType = GRAPH_WIDGET;
+
+        //not fully constructed yet, leave it pending
+        if (graphType == 0) {it++; continue;}
+
+        _graphObjectsByType[graphType][it->first] = o;
+        it = _pendingGraphObjects.erase(it);
+    }
+}
+
+bool GraphDraw::isGraphObjectType(GraphObject *obj, const int selectionFlags)
+{
+    for (const auto &graphType : {GRAPH_BLOCK, GRAPH_BREAKER, GRAPH_CONNECTION, GRAPH_WIDGET})
+    {
+        if ((selectionFlags & graphType) == 0) continue;
+        if (_graphObjectsByType[graphType].count(obj->uid()) != 0) return true;
+    }
+    return false;
+}
+
 bool GraphDraw::graphWidgetHasFocus(void)
 {
     for (auto obj : this->getGraphObjects(GRAPH_WIDGET))
@@ -353,9 +428,13 @@ QString GraphDraw::getSelectionDescription(const int selectionFlags)
 
 GraphObject *GraphDraw::getObjectById(const QString &id, const int selectionFlags)
 {
-    for (auto obj : this->getGraphObjects(selectionFlags))
+    auto it = _graphObjectsById.find(id);
+    if (it == _graphObjectsById.end()) return nullptr;
+
+    this->classifyPendingGraphObjects();
+    for (const auto &pair : it->second)
     {
-        if (obj->getId() == id) return obj;
+        if (this->isGraphObjectType(pair.second, selectionFlags)) return pair.second;
     }
     return nullptr;
 }
@@ -2,15 +2,20 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "EvalEngine/EvalEngine.hpp"
+#include "EvalEngine/TopologyEval.hpp"
 #include "GraphEditor/GraphActionsDock.hpp"
 #include "GraphEditor/GraphEditor.hpp"
 #include "GraphEditor/GraphDraw.hpp"
 #include "GraphEditor/Constants.hpp"
+#include "GraphEditor/TopologyStatsSampler.hpp"
+#include "GraphEditor/TopologyStatsRecorder.hpp"
 #include "GraphObjects/GraphBlock.hpp"
 #include "GraphObjects/GraphBreaker.hpp"
 #include "GraphObjects/GraphConnection.hpp"
 #include "GraphObjects/GraphWidget.hpp"
+#include "GraphObjects/GraphStaticText.hpp"
 #include "BlockTree/BlockTreeDock.hpp"
+#include "BlockTree/BlockCache.hpp"
 #include "AffinitySupport/AffinityZonesDock.hpp"
 #include "MainWindow/MainActions.hpp"
 #include "MainWindow/MainMenu.hpp"
@@ -29,13 +34,13 @@
 #include <QScreen>
 #include <QClipboard>
 #include <QMimeData>
-#include <QRegExp>
 #include <QTimer>
 #include <QUuid>
 #include <QFileInfo>
 #include <iostream>
 #include <cassert>
 #include <set>
+#include <map>
 #include <Pothos/Exception.hpp>
 #include <algorithm> //min/max
 
@@ -52,6 +57,8 @@ GraphEditor::GraphEditor(QWidget *parent):
     _evalEngine(new EvalEngine(this)),
     _isTopologyActive(false),
     _pollWidgetTimer(new QTimer(this)),
+    _heatmapSampler(new TopologyStatsSampler(_evalEngine, this)),
+    _heatmapRecorder(new TopologyStatsRecorder()),
     _autoActivate(false),
     _lockTopology(false)
 {
@@ -98,6 +105,8 @@ GraphEditor::GraphEditor(QWidget *parent):
     connect(actions->activateTopologyAction, SIGNAL(toggled(bool)), this, SLOT(handleToggleActivateTopology(bool)));
     connect(actions->showPortNamesAction, SIGNAL(changed(void)), this, SLOT(handleBlockDisplayModeChange(void)));
     connect(actions->eventPortsInlineAction, SIGNAL(changed(void)), this, SLOT(handleBlockDisplayModeChange(void)));
+    connect(BlockCache::global(), &BlockCache::blockDescsAdded, this, &GraphEditor::handleBlockDescsChanged);
+    connect(BlockCache::global(), &BlockCache::blockDescsChanged, this, &GraphEditor::handleBlockDescsChanged);
     connect(actions->incrementAction, SIGNAL(triggered(void)), this, SLOT(handleBlockIncrement(void)));
     connect(actions->decrementAction, SIGNAL(triggered(void)), this, SLOT(handleBlockDecrement(void)));
     connect(_moveGraphObjectsMapper, SIGNAL(mapped(int)), this, SLOT(handleMoveGraphObjects(int)));
@@ -105,6 +114,9 @@ GraphEditor::GraphEditor(QWidget *parent):
     connect(_pollWidgetTimer, &QTimer::timeout, this, &GraphEditor::handlePollWidgetTimer);
     connect(MainMenu::global()->editMenu, &QMenu::aboutToShow, this, &GraphEditor::updateGraphEditorMenus);
     connect(this, &DockingTabWidget::activeChanged, this, &GraphEditor::updateEnabledActions);
+    connect(this, &DockingTabWidget::activeChanged, this, &GraphEditor::handleHeatmapToggled);
+    connect(actions->showBottleneckHeatmapAction, &QAction::toggled, this, &GraphEditor::handleHeatmapToggled);
+    connect(_heatmapSampler, &TopologyStatsSampler::sampleReady, this, &GraphEditor::handleHeatmapSample);
     _pollWidgetTimer->start(POLL_WIDGET_CHANGES_MS);
 }
 
@@ -126,6 +138,7 @@ void GraphEditor::stopEvaluation(void)
         obj->serialize(); //causes internal stashing
     }
 
+    _heatmapSampler->setEvalEngine(nullptr);
     delete _evalEngine;
     _evalEngine = nullptr;
 }
@@ -139,16 +152,13 @@ void GraphEditor::restartEvaluation(void)
     }
 
     _evalEngine = new EvalEngine(this);
+    _heatmapSampler->setEvalEngine(_evalEngine);
     _evalEngine->submitTopology(this->getGraphObjects());
     _evalEngine->submitActivateTopology(_isTopologyActive);
 }
 
-QString GraphEditor::newId(const QString &hint, const QStringList &blacklist) const
+QString GraphEditor::newId(const QString &hint, const std::set<QString> &blacklist) const
 {
-    std::set<QString> allIds;
-    for (auto id : blacklist) allIds.insert(id);
-    for (auto obj : this->getGraphObjects()) allIds.insert(obj->getId());
-
     //either use the hint or UUID if blank
     QString idBase = hint;
     if (idBase.isEmpty())
@@ -156,22 +166,34 @@ QString GraphEditor::newId(const QString &hint, const QStringList &blacklist) co
         idBase = QUuid::createUuid().toString();
     }
 
-    //find a reasonable name and index
-    size_t index = 0;
-    QRegExp rx("(.*)(\\d+)"); rx.indexIn(idBase);
-    if (rx.captureCount() == 2 and not rx.cap(1).isEmpty() and not rx.cap(2).isEmpty())
+    //split off a numeric suffix as the starting index,
+    //otherwise continue from the last index used for this prefix
+    int digits = 0;
+    while (digits < idBase.size() and idBase.at(idBase.size()-digits-1).isDigit()) digits++;
+    const bool hasIndex = digits > 0 and digits < idBase.size();
+    size_t index = hasIndex?idBase.right(digits).toULongLong():0;
+    if (hasIndex) idBase.chop(digits);
+    auto &counter = _idPrefixCounters[idBase];
+    if (not hasIndex) index = counter;
+
+    const auto isIdInUse = [this, &blacklist](const QString &id)
     {
-        idBase = rx.cap(1);
-        index = rx.cap(2).toInt();
-    }
+        if (blacklist.count(id) != 0) return true;
+        for (int i = 0; i < this->count(); i++)
+        {
+            if (this->getGraphDraw(i)->isIdInUse(id)) return true;
+        }
+        return false;
+    };
 
     //loop for a unique ID name
     QString possibleId;
     do
     {
         possibleId = QString("%1%2").arg(idBase).arg(index++);
-    } while (allIds.find(possibleId) != allIds.end());
+    } while (isIdInUse(possibleId));
 
+    counter = std::max(counter, index);
     return possibleId;
 }
 
@@ -329,6 +351,10 @@ void GraphEditor::handleMoveGraphObjects(const int index)
     auto draw = this->getCurrentGraphDraw();
     auto desc = tr("Move %1 to %2").arg(draw->getSelectionDescription(~GRAPH_CONNECTION), this->tabText(index));
 
+    //the flattened connections see through breakers,
+    //so a move normally leaves the topology untouched
+    const auto connectionsBefore = TopologyEval::getConnectionInfo(this->getGraphObjects());
+
     //move all selected objects
     for (auto obj : draw->getObjectsSelected())
     {
@@ -436,7 +462,13 @@ void GraphEditor::handleMoveGraphObjects(const int index)
         delete conn;
     }
 
-    handleStateChange(GraphState("transform-move", desc));
+    //the objects are reparented in place and keep their uids,
+    //only re-submit when the flattened connections differ
+    this->postStateChange(GraphState("transform-move", desc));
+    const auto connectionsAfter = TopologyEval::getConnectionInfo(this->getGraphObjects());
+    if (diffConnectionInfos(connectionsBefore, connectionsAfter).empty() and
+        diffConnectionInfos(connectionsAfter, connectionsBefore).empty()) return;
+    this->updateExecutionEngine();
 }
 
 void GraphEditor::handleAddBlock(const QJsonObject &blockDesc)
@@ -567,15 +599,13 @@ void GraphEditor::handleCopy(void)
 /*!
  * paste only one object type so handlePaste can control the order of creation
  */
-static GraphObjectList handlePasteType(GraphDraw *draw, const QJsonArray &graphObjects, const QString &type)
+static GraphObjectList handlePasteType(GraphDraw *draw, const QJsonArray &graphObjects, const QString &what)
 {
     GraphObjectList newObjects;
     for (const auto &jGraphVal : graphObjects)
     {
         const auto jGraphObj = jGraphVal.toObject();
-        const auto what = jGraphObj["what"].toString();
         GraphObject *obj = nullptr;
-        if (what != type) continue;
         if (what == "Block") obj = new GraphBlock(draw);
         if (what == "Breaker") obj = new GraphBreaker(draw);
         if (what == "Connection") obj = new GraphConnection(draw);
@@ -606,50 +636,46 @@ void GraphEditor::handlePaste(void)
     //extract object array
     const auto data = mimeData->data("binary/json/pothos_object_array");
     const auto jsonDoc = QJsonDocument::fromBinaryData(data);
-    auto graphObjects = jsonDoc.array();
+    const auto graphObjects = jsonDoc.array();
 
     //rewrite ids
     std::map<QString, QString> oldIdToNew;
-    QStringList pastedIds; //prevents duplicates
+    std::set<QString> pastedIds; //prevents duplicates
     for (const auto &graphObjVal : graphObjects)
     {
         const auto jGraphObj = graphObjVal.toObject();
         const auto oldId = jGraphObj["id"].toString();
         const auto newId = this->newId(oldId, pastedIds);
-        pastedIds.push_back(newId);
+        pastedIds.insert(newId);
         oldIdToNew[oldId] = newId;
     }
-    for (int objIndex = 0; objIndex < graphObjects.size();)
+
+    //bucket the objects by type with the references rewritten,
+    //dropping objects that reference an ID outside of the paste
+    std::map<QString, QJsonArray> graphObjectsByType;
+    for (const auto &graphObjVal : graphObjects)
     {
-        auto jGraphObj = graphObjects[objIndex].toObject();
-        for (const auto &objKey : jGraphObj.keys())
+        auto jGraphObj = graphObjVal.toObject();
+        bool resolved = true;
+        for (auto it = jGraphObj.begin(); it != jGraphObj.end(); ++it)
         {
-            if (objKey.endsWith("id", Qt::CaseInsensitive))
-            {
-                //if not in oldIdToNew, remove from list
-                const auto value = jGraphObj[objKey].toString();
-                if (oldIdToNew.count(value) == 0)
-                {
-                    graphObjects.removeAt(objIndex);
-                    goto nextObj;
-                }
-                jGraphObj[objKey] = oldIdToNew[value];
-            }
-            graphObjects[objIndex] = jGraphObj; //write it back
+            if (not it.key().endsWith("id", Qt::CaseInsensitive)) continue;
+            const auto newIt = oldIdToNew.find(it.value().toString());
+            if (newIt == oldIdToNew.end()) {resolved = false; break;}
+            it.value() = newIt->second;
         }
-        objIndex++;
-        nextObj: continue;
+        if (resolved) graphObjectsByType[jGraphObj["what"].toString()].push_back(jGraphObj);
     }
 
     //unselect all objects
     draw->deselectAllObjs();
 
-    //create objects
+    //create all objects before the single state change and evaluation below
     GraphObjectList objsToMove;
-    objsToMove.append(handlePasteType(draw, graphObjects, "Block"));
-    objsToMove.append(handlePasteType(draw, graphObjects, "Breaker"));
-    handlePasteType(draw, graphObjects, "Connection"); //dont append, connection position doesnt matter
-    objsToMove.append(handlePasteType(draw, graphObjects, "Widget"));
+    objsToMove.append(handlePasteType(draw, graphObjectsByType["Block"], "Block"));
+    objsToMove.append(handlePasteType(draw, graphObjectsByType["Breaker"], "Breaker"));
+    handlePasteType(draw, graphObjectsByType["Connection"], "Connection"); //dont append, connection position doesnt matter
+    objsToMove.append(handlePasteType(draw, graphObjectsByType["Widget"], "Widget"));
 
     //deal with initial positions of pasted objects
     QPointF cornerest(1e6, 1e6);
@@ -901,23 +927,28 @@ void GraphEditor::handleAffinityZoneChanged(const QString &zone)
 
 void GraphEditor::handleStateChange(const GraphState &state)
 {
-    //always store the last display state with the state
-    //we use this to restore the last display state when undo/reset
-    _stateToLastDisplayState[_stateManager->getCurrentIndex()] = this->saveWidgetState();
-
     //empty states tell us to simply reset to the current known point
     if (state.iconName.isEmpty() and state.description.isEmpty())
     {
+        _stateToLastDisplayState[_stateManager->getCurrentIndex()] = this->saveWidgetState();
         return this->handleResetState(_stateManager->getCurrentIndex());
     }
 
+    this->postStateChange(state);
+    this->updateExecutionEngine();
+}
+
+void GraphEditor::postStateChange(const GraphState &state)
+{
+    //always store the last display state with the state
+    //we use this to restore the last display state when undo/reset
+    _stateToLastDisplayState[_stateManager->getCurrentIndex()] = this->saveWidgetState();
+
     //serialize the graph into the state manager
     GraphState stateWithDump(state);
     stateWithDump.dump = this->dumpState();
     _stateManager->post(stateWithDump);
     this->render();
-
-    this->updateExecutionEngine();
 }
 
 void GraphEditor::handleToggleActivateTopology(const bool enable)
@@ -938,6 +969,36 @@ void GraphEditor::handleBlockDisplayModeChange(void)
         block->changed();
     }
     if (this->isActive()) this->render();
+
+    const auto stats = getStaticTextCacheStats();
+    _logger.debug("Static text cache: %z hits, %z misses, %z entries", stats.hits, stats.misses, stats.entries);
+}
+
+void GraphEditor::handleBlockDescsChanged(const QJsonArray &blockDescs)
+{
+    std::map<QString, QJsonObject> pathToBlockDesc;
+    for (const auto &blockDescVal : blockDescs)
+    {
+        const auto blockDesc = blockDescVal.toObject();
+        pathToBlockDesc[blockDesc["path"].toString()] = blockDesc;
+    }
+
+    //reload only the blocks whose description changed,
+    //which also resolves blocks that were loaded with a fallback description
+    bool changed = false;
+    for (auto obj : this->getGraphObjects(GRAPH_BLOCK))
+    {
+        auto block = qobject_cast<GraphBlock *>(obj);
+        assert(block != nullptr);
+        const auto it = pathToBlockDesc.find(block->getBlockDescPath());
+        if (it == pathToBlockDesc.end()) continue;
+        if (block->getBlockDesc() == it->second) continue;
+
+        //deserialize the block's own state to keep its property values
+        block->deserialize(block->serialize());
+        changed = true;
+    }
+    if (changed) this->updateExecutionEngine();
 }
 
 void GraphEditor::handleBlockIncrement(void)
@@ -1138,9 +1199,10 @@ GraphObjectList GraphEditor::getGraphObjects(const int selectionFlags) const
 
 GraphObject *GraphEditor::getObjectById(const QString &id, const int selectionFlags)
 {
-    for (auto obj : this->getGraphObjects(selectionFlags))
+    for (int i = 0; i < this->count(); i++)
     {
-        if (obj->getId() == id) return obj;
+        auto obj = this->getGraphDraw(i)->getObjectById(id, selectionFlags);
+        if (obj != nullptr) return obj;
     }
     return nullptr;
 }
@@ -8,7 +8,11 @@
 #include "GraphEditor/DockingTabWidget.hpp"
 #include <Poco/Logger.h>
 #include <QJsonObject>
+#include <QJsonArray>
 #include <QPointer>
+#include <memory>
+#include <set>
+#include <map>
 
 class GraphConnection;
 class GraphDraw;
@@ -16,6 +20,8 @@ class QSignalMapper;
 class QTabWidget;
 class EvalEngine;
 class QTimer;
+class TopologyStatsSampler;
+class TopologyStatsRecorder;
 
 class GraphEditor : public DockingTabWidget
 {
@@ -39,11 +45,13 @@ public:
      * taking into account the IDs used by all objects within the graph.
      * The blacklist is currently used during the handle paste operation
      * to prevent ID duplicates before the pasted blocks are instantiated.
+     * IDs are looked up in the ID index of each graph page,
+     * and a counter per ID prefix skips over the indexes already handed out.
      * \param hint an optional string to guide the name of the new ID.
-     * \param blacklist a list of IDs that are not allowed to be used
+     * \param blacklist a set of IDs that are not allowed to be used
      * \return a new ID that is unique to the graph
      */
-    QString newId(const QString &hint = "", const QStringList &blacklist = QStringList()) const;
+    QString newId(const QString &hint = "", const std::set<QString> &blacklist = std::set<QString>()) const;
 
     //! Serializes the editor and saves to file.
     void save(void);
@@ -181,11 +189,14 @@ private slots:
     void handleShowTopologyStatsDialog(void);
     void handleToggleActivateTopology(bool);
     void handleBlockDisplayModeChange(void);
+    void handleBlockDescsChanged(const QJsonArray &blockDescs);
     void handleBlockIncrement(void);
     void handleBlockDecrement(void);
     void handleBlockXcrement(const int adj);
     void handleEvalEngineDeactivate(void);
     void handlePollWidgetTimer(void);
+    void handleHeatmapToggled(void);
+    void handleHeatmapSample(const QByteArray &jsonStats);
 
 private:
     Poco::Logger &_logger;
@@ -206,16 +217,27 @@ private:
     QPointer<GraphStateManager> _stateManager;
     std::map<size_t, QVariant> _stateToLastDisplayState;
 
+    //! next index to try for each ID prefix in newId()
+    mutable std::map<QString, size_t> _idPrefixCounters;
+
     //! update enabled actions based on state - after a change or when editor becomes visible
     void updateEnabledActions(void);
 
     //! called after state changes
     void updateExecutionEngine(void);
 
+    //! post the state to the undo stack and render without touching the eval engine
+    void postStateChange(const GraphState &state);
+
     EvalEngine *_evalEngine;
     bool _isTopologyActive;
     QTimer *_pollWidgetTimer;
 
+    //live stats overlay on the graph
+    void clearHeatmap(void);
+    TopologyStatsSampler *_heatmapSampler;
+    std::unique_ptr<TopologyStatsRecorder> _heatmapRecorder;
+
     //graph globals/constant expressions
     QStringList _globalNames;
     std::map<QString, QString> _globalExprs;
@@ -0,0 +1,82 @@
+// Copyright (c) 2015-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "GraphEditor/GraphEditor.hpp"
+#include "GraphEditor/Constants.hpp"
+#include "GraphEditor/TopologyStatsSampler.hpp"
+#include "GraphEditor/TopologyStatsRecorder.hpp"
+#include "GraphObjects/GraphBlock.hpp"
+#include "GraphObjects/GraphConnection.hpp"
+#include "MainWindow/MainActions.hpp"
+#include <QJsonDocument>
+#include <QDateTime>
+#include <QAction>
+#include <map>
+
+void GraphEditor::handleHeatmapToggled(void)
+{
+    //only the visible editor samples its topology
+    const bool enabled = MainActions::global()->showBottleneckHeatmapAction->isChecked();
+    _heatmapSampler->setActive(enabled and this->isActive());
+    if (enabled) return;
+
+    _heatmapRecorder->clear();
+    this->clearHeatmap();
+}
+
+void GraphEditor::handleHeatmapSample(const QByteArray &jsonStats)
+{
+    if (not _isTopologyActive or not _heatmapSampler->isActive()) return this->clearHeatmap();
+
+    //the topology is busy being modified, keep the last overlay
+    if (jsonStats.isNull()) return;
+
+    const auto timeNs = QDateTime::currentMSecsSinceEpoch()*1000000;
+    _heatmapRecorder->update(QJsonDocument::fromJson(jsonStats).object(), timeNs);
+
+    //the topology names each block after its graph block ID
+    std::map<QString, const TopologyBlockStats *> statsById;
+    for (const auto &pair : _heatmapRecorder->blocks())
+    {
+        statsById[pair.second.blockName] = &pair.second;
+    }
+
+    //tint each block by its fraction of time spent in work()
+    for (auto obj : this->getGraphObjects(GRAPH_BLOCK))
+    {
+        auto block = qobject_cast<GraphBlock *>(obj);
+        const auto it = statsById.find(block->getId());
+        if (it == statsById.end()) block->setHeatmapLevel(-1.0);
+        else block->setHeatmapLevel(it->second->block.latest().dutyCycle);
+    }
+
+    //label each connection with the throughput of its source port
+    for (auto obj : this->getGraphObjects(GRAPH_CONNECTION))
+    {
+        auto conn = qobject_cast<GraphConnection *>(obj);
+        const auto &ep = conn->getOutputEndpoint();
+        auto srcBlock = qobject_cast<GraphBlock *>(ep.getObj().data());
+        const auto it = (srcBlock == nullptr)?statsById.end():statsById.find(srcBlock->getId());
+        if (it == statsById.end()) {conn->setThroughputText(QString()); continue;}
+
+        const auto &outputs = it->second->outputs;
+        const auto portIt = outputs.find(ep.getKey().id);
+        if (portIt == outputs.end()) {conn->setThroughputText(QString()); continue;}
+
+        const auto rates = portIt->second.latest();
+        if (conn->isSignalOrSlot()) conn->setThroughputText(tr("%1msg/s").arg(formatStatsRate(rates.messagesPerSec)));
+        else conn->setThroughputText(tr("%1/s").arg(formatStatsRate(rates.elementsPerSec)));
+    }
+}
+
+void GraphEditor::clearHeatmap(void)
+{
+    for (auto obj : this->getGraphObjects(GRAPH_BLOCK))
+    {
+        qobject_cast<GraphBlock *>(obj)->setHeatmapLevel(-1.0);
+    }
+    for (auto obj : this->getGraphObjects(GRAPH_CONNECTION))
+    {
+        qobject_cast<GraphConnection *>(obj)->setThroughputText(QString());
+    }
+}
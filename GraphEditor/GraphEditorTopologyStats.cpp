@@ -3,21 +3,114 @@
 
 #include "MainWindow/IconUtils.hpp"
 #include "GraphEditor/GraphEditor.hpp"
-#include "EvalEngine/EvalEngine.hpp"
+#include "MainWindow/MainSettings.hpp"
+#include "GraphEditor/TopologyStatsRecorder.hpp"
+#include "GraphEditor/TopologyStatsRecording.hpp"
+#include "GraphEditor/TopologyStatsSampler.hpp"
 #include <QDialog>
-#include <QTimer>
-#include <QLabel>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QPushButton>
+#include <QSpinBox>
 #include <QMessageBox>
-#include <QFuture>
-#include <QFutureWatcher>
-#include <QScrollArea>
+#include <QFileDialog>
+#include <QFileInfo>
 #include <QTreeWidget>
-#include <QtConcurrent/QtConcurrent>
+#include <QHeaderView>
+#include <QElapsedTimer>
+#include <QPainter>
+#include <QPixmap>
 #include <QJsonDocument>
-#include <functional> //std::bind
+#include <algorithm> //max
+
+static const int SparklineWidth = 120;
+static const int SparklineHeight = 20;
+
+//! Recordings rotate into numbered backups past this size
+static const qint64 RecordingMaxBytes = 16*1024*1024;
+static const int RecordingMaxBackups = 4;
+
+enum TopologyStatsColumn
+{
+    STATS_COL_NAME,
+    STATS_COL_ELEMENTS,
+    STATS_COL_BYTES,
+    STATS_COL_MESSAGES,
+    STATS_COL_DUTY,
+    STATS_COL_HISTORY,
+    STATS_NUM_COLS
+};
+
+//! Draw the element rate history as a small line plot
+static QPixmap makeSparkline(const std::vector<TopologyStatsRates> &rates)
+{
+    QPixmap pixmap(SparklineWidth, SparklineHeight);
+    pixmap.fill(Qt::transparent);
+    if (rates.size() < 2) return pixmap;
+
+    double maxRate = 0.0;
+    for (const auto &r : rates) maxRate = std::max(maxRate, r.elementsPerSec);
+    if (maxRate <= 0.0) maxRate = 1.0;
+
+    QPolygonF line;
+    for (size_t i = 0; i < rates.size(); i++)
+    {
+        const qreal x = (SparklineWidth-1)*qreal(i)/(rates.size()-1);
+        const qreal y = (SparklineHeight-2)*(1.0 - rates[i].elementsPerSec/maxRate) + 1;
+        line << QPointF(x, y);
+    }
+    QPainter painter(&pixmap);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QPen(QColor("#3465A4"), 1.5));
+    painter.drawPolyline(line);
+    return pixmap;
+}
+
+/***********************************************************************
+ * Tree item that sorts numeric columns by value
+ **********************************************************************/
+class TopologyStatsItem : public QTreeWidgetItem
+{
+public:
+    TopologyStatsItem(const QString &title)
+    {
+        this->setText(STATS_COL_NAME, title);
+        for (int col = STATS_COL_ELEMENTS; col < STATS_COL_HISTORY; col++)
+        {
+            this->setTextAlignment(col, Qt::AlignRight | Qt::AlignVCenter);
+        }
+    }
+
+    void setRates(const TopologyStatsHistory &history)
+    {
+        const auto rates = history.latest();
+        this->setValue(STATS_COL_ELEMENTS, rates.elementsPerSec, formatStatsRate(rates.elementsPerSec));
+        this->setValue(STATS_COL_BYTES, rates.bytesPerSec, formatStatsRate(rates.bytesPerSec)+"B");
+        this->setValue(STATS_COL_MESSAGES, rates.messagesPerSec, formatStatsRate(rates.messagesPerSec));
+        this->setData(STATS_COL_HISTORY, Qt::DecorationRole, makeSparkline(history.rates()));
+    }
+
+    void setDutyCycle(const double dutyCycle)
+    {
+        this->setValue(STATS_COL_DUTY, dutyCycle, QString("%1 %").arg(dutyCycle*100, 0, 'f', 1));
+    }
+
+    bool operator<(const QTreeWidgetItem &other) const
+    {
+        const int col = (this->treeWidget() == nullptr)?0:this->treeWidget()->sortColumn();
+        const auto a = this->data(col, Qt::UserRole);
+        const auto b = other.data(col, Qt::UserRole);
+        if (a.isValid() and b.isValid()) return a.toDouble() < b.toDouble();
+        return QTreeWidgetItem::operator<(other);
+    }
+
+private:
+    void setValue(const int col, const double value, const QString &text)
+    {
+        this->setData(col, Qt::UserRole, value);
+        this->setText(col, text);
+    }
+};
 
 class TopologyStatsDialog : public QDialog
 {
@@ -27,34 +120,62 @@ public:
     TopologyStatsDialog(EvalEngine *evalEngine, GraphEditor *parent):
         QDialog(parent),
         _graphEditor(parent),
-        _evalEngine(evalEngine),
         _topLayout(new QVBoxLayout(this)),
         _manualReloadButton(new QPushButton(makeIconFromTheme("view-refresh"), tr("Manual Reload"), this)),
         _autoReloadButton(new QPushButton(makeIconFromTheme("view-refresh"), tr("Automatic Reload"), this)),
-        _statsScroller(new QScrollArea(this)),
+        _intervalSpinBox(new QSpinBox(this)),
+        _recordButton(new QPushButton(makeIconFromTheme("media-record"), tr("Record..."), this)),
+        _replayButton(new QPushButton(makeIconFromTheme("document-open"), tr("Replay..."), this)),
         _statsTree(new QTreeWidget(this)),
-        _timer(new QTimer(this)),
-        _watcher(new QFutureWatcher<QByteArray>(this))
+        _sampler(new TopologyStatsSampler(evalEngine, this)),
+        _replayMode(false)
     {
         //create layouts
         auto formsLayout = new QHBoxLayout();
         _topLayout->addLayout(formsLayout);
         formsLayout->addWidget(_manualReloadButton);
         formsLayout->addWidget(_autoReloadButton);
-        _topLayout->addWidget(_statsScroller);
+        formsLayout->addWidget(_intervalSpinBox);
+        formsLayout->addWidget(_recordButton);
+        formsLayout->addWidget(_replayButton);
+        _topLayout->addWidget(_statsTree);
 
         //setup the refresh buttons
         _autoReloadButton->setCheckable(true);
+        _recordButton->setCheckable(true);
+        _recordButton->setToolTip(tr("Record the stats samples to a file"));
+        _replayButton->setToolTip(tr("Display the stats from a recording instead of live data"));
+
+        //setup the sample interval
+        _intervalSpinBox->setRange(100, 60000);
+        _intervalSpinBox->setSingleStep(100);
+        _intervalSpinBox->setSuffix(tr(" ms"));
+        _intervalSpinBox->setToolTip(tr("Automatic reload interval"));
+        _intervalSpinBox->setValue(MainSettings::global()->value("TopologyStats/intervalMs", 1000).toInt());
+        _sampler->setInterval(_intervalSpinBox->value());
 
-        //setup the JSON stats tree
-        _statsScroller->setWidget(_statsTree);
-        _statsScroller->setWidgetResizable(true);
+        //setup the stats tree columns
+        _statsTree->setColumnCount(STATS_NUM_COLS);
+        _statsTree->setHeaderLabels(QStringList()
+            << QString()
+            << tr("Elements/s")
+            << tr("Bytes/s")
+            << tr("Messages/s")
+            << tr("Work")
+            << tr("History"));
+        _statsTree->setIconSize(QSize(SparklineWidth, SparklineHeight));
+        _statsTree->setSortingEnabled(true);
+        _statsTree->sortByColumn(STATS_COL_NAME, Qt::AscendingOrder);
+        _statsTree->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+        _sampleTime.start();
 
         //connect the signals
         connect(_manualReloadButton, &QPushButton::pressed, this, &TopologyStatsDialog::handleManualReload);
         connect(_autoReloadButton, &QPushButton::clicked, this, &TopologyStatsDialog::handleAutomaticReload);
-        connect(_timer, &QTimer::timeout, this, &TopologyStatsDialog::handleManualReload);
-        connect(_watcher, &QFutureWatcher<QByteArray>::finished, this, &TopologyStatsDialog::handleWatcherDone);
+        connect(_intervalSpinBox, SIGNAL(valueChanged(int)), this, SLOT(handleIntervalChanged(int)));
+        connect(_recordButton, &QPushButton::clicked, this, &TopologyStatsDialog::handleRecordClicked);
+        connect(_replayButton, &QPushButton::pressed, this, &TopologyStatsDialog::handleReplayPressed);
+        connect(_sampler, &TopologyStatsSampler::sampleReady, this, &TopologyStatsDialog::handleSampleReady);
         connect(_graphEditor, &GraphEditor::windowTitleUpdated, this, &TopologyStatsDialog::handleWindowTitleUpdated);
 
         //initialize
@@ -66,22 +187,63 @@ private slots:
     void handleManualReload(void)
     {
         this->updateStatusLabel(tr("Manual loading"));
-        _watcher->setFuture(QtConcurrent::run(std::bind(&EvalEngine::getTopologyJSONStats, _evalEngine)));
+        _sampler->sampleNow();
     }
 
     void handleAutomaticReload(const bool enb)
     {
-        if (enb) _timer->start(1000);
-        else _timer->stop();
+        _sampler->setActive(enb);
         if (enb) this->updateStatusLabel(tr("Automatic loading"));
         else this->updateStatusLabel(tr("Automatic stopped"));
     }
 
-    void handleWatcherDone(void)
+    void handleIntervalChanged(const int intervalMs)
+    {
+        _sampler->setInterval(intervalMs);
+        MainSettings::global()->setValue("TopologyStats/intervalMs", intervalMs);
+    }
+
+    void handleRecordClicked(const bool enb)
     {
-        const auto jsonStats = _watcher->result();
+        if (not enb) return _writer.close();
 
-        if (_timer->isActive())
+        const auto path = QFileDialog::getSaveFileName(this, tr("Record topology stats"),
+            QString(), tr("Stats recordings (*.jsonl)"));
+        if (path.isEmpty() or not _writer.open(path, RecordingMaxBytes, RecordingMaxBackups))
+        {
+            if (not path.isEmpty()) QMessageBox::critical(this, tr("Record topology stats"),
+                tr("Cannot open %1: %2").arg(path).arg(_writer.errorString()));
+            _recordButton->setChecked(false);
+        }
+    }
+
+    void handleReplayPressed(void)
+    {
+        const auto path = QFileDialog::getOpenFileName(this, tr("Replay topology stats"),
+            QString(), tr("Stats recordings (*.jsonl);;All files (*)"));
+        if (path.isEmpty()) return;
+
+        QString errorString;
+        const auto frames = loadTopologyStatsRecording(path, errorString);
+        if (not errorString.isEmpty())
+        {
+            QMessageBox::critical(this, tr("Replay topology stats"), tr("Cannot load %1: %2").arg(path).arg(errorString));
+            if (frames.empty()) return;
+        }
+
+        //stop live updates and display the recording
+        _autoReloadButton->setChecked(false);
+        this->handleAutomaticReload(false);
+        this->resetDisplay();
+        _replayMode = true;
+        for (const auto &frame : frames) _recorder.update(frame.second, frame.first);
+        this->updateDisplay();
+        this->updateStatusLabel(tr("Replay of %1").arg(QFileInfo(path).fileName()));
+    }
+
+    void handleSampleReady(const QByteArray &jsonStats)
+    {
+        if (_sampler->isActive())
         {
             if (jsonStats.isNull()) this->updateStatusLabel(tr("Automatic holding"));
             else this->updateStatusLabel(tr("Automatic acquisition"));
@@ -95,35 +257,20 @@ private slots:
         //the topology is not active, leave the stats up for display
         if (jsonStats.isNull()) return;
 
-        //update the status display
-        const auto result = QJsonDocument::fromJson(jsonStats);
-        const auto topObj = result.object();
-        for (const auto &name : topObj.keys())
-        {
-            const auto dataObj = topObj[name].toObject();
-
-            auto &item = _statsItems[name];
-            if (item == nullptr)
-            {
-                const auto title = dataObj["blockName"].toString();
-                item = new QTreeWidgetItem(QStringList(title));
-                _statsTree->addTopLevelItem(item);
-            }
-
-            auto &label = _statsLabels[name];
-            if (label == nullptr)
-            {
-                label = new QLabel(_statsTree);
-                label->setStyleSheet("QLabel{background:white;margin:1px;}");
-                label->setWordWrap(true);
-                label->setAlignment(Qt::AlignTop | Qt::AlignLeft);
-                label->setTextInteractionFlags(Qt::TextSelectableByMouse);
-                auto subItem = new QTreeWidgetItem(item);
-                _statsTree->setItemWidget(subItem, 0, label);
-            }
+        //live data replaces a replayed recording
+        if (_replayMode) this->resetDisplay();
 
-            label->setText(QJsonDocument(dataObj).toJson(QJsonDocument::Indented));
+        //record the new sample
+        const auto topStats = QJsonDocument::fromJson(jsonStats).object();
+        const auto timeNs = _sampleTime.nsecsElapsed();
+        _recorder.update(topStats, timeNs);
+        if (_writer.isOpen() and not _writer.write(timeNs, topStats))
+        {
+            _writer.close();
+            _recordButton->setChecked(false);
+            QMessageBox::critical(this, tr("Record topology stats"), tr("Recording stopped: %1").arg(_writer.errorString()));
         }
+        this->updateDisplay();
     }
 
     void handleWindowTitleUpdated(void)
@@ -135,20 +282,72 @@ private slots:
 private:
     void updateStatusLabel(const QString &st)
     {
-        _statsTree->setHeaderLabel(tr("Block Stats - %1").arg(st));
+        _statsTree->headerItem()->setText(STATS_COL_NAME, tr("Block Stats - %1").arg(st));
+    }
+
+    void resetDisplay(void)
+    {
+        _replayMode = false;
+        _recorder.clear();
+        _statsItems.clear();
+        _portItems.clear();
+        _statsTree->clear();
+    }
+
+    void updateDisplay(void)
+    {
+        //sorting is suspended while items change
+        _statsTree->setSortingEnabled(false);
+        for (const auto &pair : _recorder.blocks())
+        {
+            const auto &stats = pair.second;
+            auto &item = _statsItems[pair.first];
+            if (item == nullptr)
+            {
+                item = new TopologyStatsItem(stats.blockName);
+                _statsTree->addTopLevelItem(item);
+            }
+            item->setRates(stats.block);
+            item->setDutyCycle(stats.block.latest().dutyCycle);
+
+            for (const auto &port : stats.inputs)
+            {
+                this->getPortItem(item, pair.first, port.first, true)->setRates(port.second);
+            }
+            for (const auto &port : stats.outputs)
+            {
+                this->getPortItem(item, pair.first, port.first, false)->setRates(port.second);
+            }
+        }
+        _statsTree->setSortingEnabled(true);
+    }
+
+    TopologyStatsItem *getPortItem(TopologyStatsItem *blockItem, const QString &id, const QString &portName, const bool isInput)
+    {
+        auto &item = _portItems[id + (isInput?"/in/":"/out/") + portName];
+        if (item == nullptr)
+        {
+            item = new TopologyStatsItem(isInput?tr("Input %1").arg(portName):tr("Output %1").arg(portName));
+            blockItem->addChild(item);
+        }
+        return item;
     }
 
     GraphEditor *_graphEditor;
-    EvalEngine *_evalEngine;
     QVBoxLayout *_topLayout;
     QPushButton *_manualReloadButton;
     QPushButton *_autoReloadButton;
-    QScrollArea *_statsScroller;
+    QSpinBox *_intervalSpinBox;
+    QPushButton *_recordButton;
+    QPushButton *_replayButton;
     QTreeWidget *_statsTree;
-    QTimer *_timer;
-    QFutureWatcher<QByteArray> *_watcher;
-    std::map<QString, QTreeWidgetItem *> _statsItems;
-    std::map<QString, QLabel *> _statsLabels;
+    TopologyStatsSampler *_sampler;
+    QElapsedTimer _sampleTime;
+    TopologyStatsRecorder _recorder;
+    TopologyStatsWriter _writer;
+    bool _replayMode;
+    std::map<QString, TopologyStatsItem *> _statsItems;
+    std::map<QString, TopologyStatsItem *> _portItems;
 };
 
 void GraphEditor::handleShowTopologyStatsDialog(void)
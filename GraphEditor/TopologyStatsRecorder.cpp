@@ -0,0 +1,209 @@
+// Copyright (c) 2015-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "GraphEditor/TopologyStatsRecorder.hpp"
+#include <Pothos/Framework/DType.hpp>
+#include <Pothos/Exception.hpp>
+#include <QJsonArray>
+#include <QJsonValue>
+#include <functional>
+#include <algorithm> //min/max
+
+/***********************************************************************
+ * counters and rates
+ **********************************************************************/
+TopologyStatsCounters::TopologyStatsCounters(void):
+    timeNs(0),
+    elements(0.0),
+    bytes(0.0),
+    messages(0.0),
+    workTimeNs(0.0)
+{
+    return;
+}
+
+TopologyStatsRates::TopologyStatsRates(void):
+    timeNs(0),
+    elementsPerSec(0.0),
+    bytesPerSec(0.0),
+    messagesPerSec(0.0),
+    dutyCycle(0.0)
+{
+    return;
+}
+
+/***********************************************************************
+ * ring buffer history
+ **********************************************************************/
+TopologyStatsHistory::TopologyStatsHistory(const size_t capacity):
+    _hasLast(false),
+    _ring(capacity),
+    _head(0),
+    _size(0)
+{
+    return;
+}
+
+void TopologyStatsHistory::push(const TopologyStatsCounters &counters)
+{
+    const auto last = _last;
+    const bool hasLast = _hasLast;
+    _last = counters;
+    _hasLast = true;
+
+    //need two samples and forward progress in time for a rate
+    if (not hasLast or _ring.empty()) return;
+    const qint64 deltaNs = counters.timeNs - last.timeNs;
+    if (deltaNs <= 0) return;
+    const double deltaSecs = deltaNs/1e9;
+
+    //counters reset when the topology is re-created, clip to zero
+    TopologyStatsRates rates;
+    rates.timeNs = counters.timeNs;
+    rates.elementsPerSec = std::max(0.0, counters.elements - last.elements)/deltaSecs;
+    rates.bytesPerSec = std::max(0.0, counters.bytes - last.bytes)/deltaSecs;
+    rates.messagesPerSec = std::max(0.0, counters.messages - last.messages)/deltaSecs;
+    rates.dutyCycle = std::min(1.0, std::max(0.0, counters.workTimeNs - last.workTimeNs)/deltaNs);
+
+    _ring[_head] = rates;
+    _head = (_head + 1) % _ring.size();
+    _size = std::min(_size + 1, _ring.size());
+}
+
+TopologyStatsRates TopologyStatsHistory::latest(void) const
+{
+    if (_size == 0) return TopologyStatsRates();
+    return _ring[(_head + _ring.size() - 1) % _ring.size()];
+}
+
+std::vector<TopologyStatsRates> TopologyStatsHistory::rates(void) const
+{
+    std::vector<TopologyStatsRates> out;
+    out.reserve(_size);
+    const size_t start = (_head + _ring.size() - _size) % std::max<size_t>(1, _ring.size());
+    for (size_t i = 0; i < _size; i++)
+    {
+        out.push_back(_ring[(start + i) % _ring.size()]);
+    }
+    return out;
+}
+
+/***********************************************************************
+ * JSON stats parsing
+ **********************************************************************/
+static double dtypeSize(const QString &dtype)
+{
+    if (dtype.isEmpty()) return 1.0;
+    try
+    {
+        return double(Pothos::DType(dtype.toStdString()).size());
+    }
+    catch (const Pothos::Exception &)
+    {
+        return 1.0;
+    }
+}
+
+//! Port stats come as an array in port order or as an object keyed by port name
+static void forEachPortStats(const QJsonValue &value, const std::function<void(const QString &, const QJsonObject &)> &fcn)
+{
+    if (value.isObject())
+    {
+        const auto obj = value.toObject();
+        for (const auto &name : obj.keys()) fcn(name, obj[name].toObject());
+    }
+    else if (value.isArray())
+    {
+        const auto arr = value.toArray();
+        for (int i = 0; i < arr.size(); i++)
+        {
+            const auto portObj = arr.at(i).toObject();
+            auto name = portObj["name"].toString();
+            if (name.isEmpty()) name = QString::number(i);
+            fcn(name, portObj);
+        }
+    }
+}
+
+static TopologyStatsCounters portCounters(const QJsonObject &portObj, const qint64 timeNs)
+{
+    TopologyStatsCounters counters;
+    counters.timeNs = timeNs;
+    counters.elements = portObj["totalElements"].toDouble();
+    counters.bytes = counters.elements*dtypeSize(portObj["dtype"].toString());
+    counters.messages = portObj["totalMessages"].toDouble();
+    return counters;
+}
+
+QString formatStatsRate(const double rate)
+{
+    static const char *prefixes[] = {"", "k", "M", "G", "T"};
+    double value = rate;
+    size_t i = 0;
+    while (value >= 1000.0 and i+1 < sizeof(prefixes)/sizeof(prefixes[0]))
+    {
+        value /= 1000.0;
+        i++;
+    }
+    return QString("%1 %2").arg(value, 0, 'f', (i == 0)?0:2).arg(prefixes[i]);
+}
+
+/***********************************************************************
+ * stats recorder
+ **********************************************************************/
+TopologyStatsRecorder::TopologyStatsRecorder(const size_t capacity):
+    _capacity(capacity)
+{
+    return;
+}
+
+void TopologyStatsRecorder::update(const QJsonObject &topStats, const qint64 timeNs)
+{
+    for (const auto &id : topStats.keys())
+    {
+        const auto dataObj = topStats[id].toObject();
+
+        //prefer the query time from the stats for accurate rates
+        const auto queryTime = dataObj["timeStatsQuery"];
+        const qint64 sampleTimeNs = queryTime.isDouble()?qint64(queryTime.toDouble()):timeNs;
+
+        auto it = _blocks.find(id);
+        if (it == _blocks.end())
+        {
+            it = _blocks.emplace(id, TopologyBlockStats()).first;
+            it->second.block = TopologyStatsHistory(_capacity);
+        }
+        auto &stats = it->second;
+        stats.blockName = dataObj["blockName"].toString();
+
+        TopologyStatsCounters inputTotals, outputTotals;
+        const auto recordPorts = [this, sampleTimeNs](
+            const QJsonValue &value,
+            std::map<QString, TopologyStatsHistory> &histories,
+            TopologyStatsCounters &totals)
+        {
+            forEachPortStats(value, [&](const QString &name, const QJsonObject &portObj)
+            {
+                const auto counters = portCounters(portObj, sampleTimeNs);
+                auto portIt = histories.find(name);
+                if (portIt == histories.end()) portIt = histories.emplace(name, TopologyStatsHistory(_capacity)).first;
+                portIt->second.push(counters);
+                totals.elements += counters.elements;
+                totals.bytes += counters.bytes;
+                totals.messages += counters.messages;
+            });
+        };
+        recordPorts(dataObj["inputStats"], stats.inputs, inputTotals);
+        recordPorts(dataObj["outputStats"], stats.outputs, outputTotals);
+
+        auto blockCounters = stats.outputs.empty()?inputTotals:outputTotals;
+        blockCounters.timeNs = sampleTimeNs;
+        blockCounters.workTimeNs = dataObj["totalTimeWork"].toDouble();
+        stats.block.push(blockCounters);
+    }
+}
+
+void TopologyStatsRecorder::clear(void)
+{
+    _blocks.clear();
+}
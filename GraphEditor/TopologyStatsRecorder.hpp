@@ -0,0 +1,103 @@
+// Copyright (c) 2015-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <QJsonObject>
+#include <QString>
+#include <QtGlobal>
+#include <vector>
+#include <map>
+
+//! Cumulative counters from a single stats query of a block or port
+struct TopologyStatsCounters
+{
+    TopologyStatsCounters(void);
+    qint64 timeNs;
+    double elements;
+    double bytes;
+    double messages;
+    double workTimeNs;
+};
+
+//! Rates computed between two consecutive stats samples
+struct TopologyStatsRates
+{
+    TopologyStatsRates(void);
+    qint64 timeNs;
+    double elementsPerSec;
+    double bytesPerSec;
+    double messagesPerSec;
+    double dutyCycle; //fraction of the interval spent in work()
+};
+
+/*!
+ * A fixed capacity ring buffer of rates for one block or port.
+ * Each pushed sample of cumulative counters produces one rate
+ * entry from the difference with the previous sample.
+ */
+class TopologyStatsHistory
+{
+public:
+    TopologyStatsHistory(const size_t capacity = 0);
+
+    //! Push a new sample of cumulative counters
+    void push(const TopologyStatsCounters &counters);
+
+    //! The most recent rates (zeros before two samples)
+    TopologyStatsRates latest(void) const;
+
+    //! All recorded rates in chronological order
+    std::vector<TopologyStatsRates> rates(void) const;
+
+private:
+    TopologyStatsCounters _last;
+    bool _hasLast;
+    std::vector<TopologyStatsRates> _ring;
+    size_t _head;
+    size_t _size;
+};
+
+//! The recorded history of a block and its ports
+struct TopologyBlockStats
+{
+    QString blockName;
+    TopologyStatsHistory block;
+    std::map<QString, TopologyStatsHistory> inputs;
+    std::map<QString, TopologyStatsHistory> outputs;
+};
+
+//! Format a rate with a metric prefix for display
+QString formatStatsRate(const double rate);
+
+/*!
+ * The stats recorder turns the JSON from Topology::queryJSONStats()
+ * into a per-block and per-port time series of rates.
+ * Block rates are summed over the output ports,
+ * or over the input ports for blocks without outputs.
+ */
+class TopologyStatsRecorder
+{
+public:
+    TopologyStatsRecorder(const size_t capacity = 120);
+
+    /*!
+     * Record a new stats sample.
+     * \param topStats the stats object keyed by block ID
+     * \param timeNs the sample time, used when the stats lack a query time
+     */
+    void update(const QJsonObject &topStats, const qint64 timeNs);
+
+    //! Get the recorded stats keyed by block ID
+    const std::map<QString, TopologyBlockStats> &blocks(void) const
+    {
+        return _blocks;
+    }
+
+    //! Discard all recorded history
+    void clear(void);
+
+private:
+    const size_t _capacity;
+    std::map<QString, TopologyBlockStats> _blocks;
+};
@@ -0,0 +1,168 @@
+// Copyright (c) 2015-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "GraphEditor/TopologyStatsRecording.hpp"
+#include <QJsonDocument>
+#include <QJsonValue>
+#include <QObject> //tr
+
+/***********************************************************************
+ * delta encoding helpers
+ **********************************************************************/
+static QJsonObject diffStats(const QJsonObject &last, const QJsonObject &next)
+{
+    QJsonObject delta;
+    for (const auto &id : next.keys())
+    {
+        const auto nextBlock = next[id].toObject();
+        const auto lastBlock = last[id].toObject();
+        QJsonObject blockDelta;
+        for (const auto &key : nextBlock.keys())
+        {
+            if (nextBlock[key] != lastBlock[key]) blockDelta[key] = nextBlock[key];
+        }
+        if (not blockDelta.isEmpty() or not last.contains(id)) delta[id] = blockDelta;
+    }
+
+    //blocks that left the topology
+    for (const auto &id : last.keys())
+    {
+        if (not next.contains(id)) delta[id] = QJsonValue::Null;
+    }
+    return delta;
+}
+
+static void applyStatsDelta(QJsonObject &stats, const QJsonObject &delta)
+{
+    for (const auto &id : delta.keys())
+    {
+        if (delta[id].isNull())
+        {
+            stats.remove(id);
+            continue;
+        }
+        auto block = stats[id].toObject();
+        const auto blockDelta = delta[id].toObject();
+        for (const auto &key : blockDelta.keys()) block[key] = blockDelta[key];
+        stats[id] = block;
+    }
+}
+
+/***********************************************************************
+ * recording writer
+ **********************************************************************/
+TopologyStatsWriter::TopologyStatsWriter(void):
+    _maxBytes(0),
+    _maxBackups(0),
+    _nextIsKeyframe(true)
+{
+    return;
+}
+
+TopologyStatsWriter::~TopologyStatsWriter(void)
+{
+    this->close();
+}
+
+bool TopologyStatsWriter::open(const QString &path, const qint64 maxBytes, const int maxBackups)
+{
+    this->close();
+    _path = path;
+    _maxBytes = maxBytes;
+    _maxBackups = maxBackups;
+    _nextIsKeyframe = true;
+    _lastStats = QJsonObject();
+    _file.setFileName(path);
+    if (_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return true;
+    _errorString = _file.errorString();
+    return false;
+}
+
+void TopologyStatsWriter::close(void)
+{
+    if (_file.isOpen()) _file.close();
+}
+
+bool TopologyStatsWriter::isOpen(void) const
+{
+    return _file.isOpen();
+}
+
+bool TopologyStatsWriter::write(const qint64 timeNs, const QJsonObject &stats)
+{
+    if (not _file.isOpen()) return false;
+    if (_maxBytes > 0 and _file.size() >= _maxBytes and not this->rotate()) return false;
+
+    QJsonObject frame;
+    frame["t"] = QString::number(timeNs); //string keeps full precision
+    frame["k"] = _nextIsKeyframe;
+    frame["s"] = _nextIsKeyframe?stats:diffStats(_lastStats, stats);
+    _lastStats = stats;
+    _nextIsKeyframe = false;
+
+    const auto line = QJsonDocument(frame).toJson(QJsonDocument::Compact) + "\n";
+    if (_file.write(line) == line.size()) return true;
+    _errorString = _file.errorString();
+    return false;
+}
+
+bool TopologyStatsWriter::rotate(void)
+{
+    _file.close();
+
+    //shift the backups: path.N-1 -> path.N ... path -> path.1
+    QFile::remove(QString("%1.%2").arg(_path).arg(_maxBackups));
+    for (int i = _maxBackups-1; i >= 1; i--)
+    {
+        QFile::rename(QString("%1.%2").arg(_path).arg(i), QString("%1.%2").arg(_path).arg(i+1));
+    }
+    if (_maxBackups > 0) QFile::rename(_path, _path + ".1");
+
+    _nextIsKeyframe = true;
+    if (_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return true;
+    _errorString = _file.errorString();
+    return false;
+}
+
+/***********************************************************************
+ * recording reader
+ **********************************************************************/
+std::vector<TopologyStatsFrame> loadTopologyStatsRecording(const QString &path, QString &errorString)
+{
+    std::vector<TopologyStatsFrame> frames;
+    QFile file(path);
+    if (not file.open(QIODevice::ReadOnly))
+    {
+        errorString = file.errorString();
+        return frames;
+    }
+
+    QJsonObject stats;
+    bool haveKeyframe = false;
+    size_t lineNo = 0;
+    while (not file.atEnd())
+    {
+        const auto line = file.readLine().trimmed();
+        lineNo++;
+        if (line.isEmpty()) continue;
+
+        QJsonParseError parseError;
+        const auto frame = QJsonDocument::fromJson(line, &parseError).object();
+        if (parseError.error != QJsonParseError::NoError)
+        {
+            errorString = QObject::tr("Line %1: %2").arg(lineNo).arg(parseError.errorString());
+            return frames;
+        }
+
+        if (frame["k"].toBool())
+        {
+            stats = frame["s"].toObject();
+            haveKeyframe = true;
+        }
+        else if (haveKeyframe) applyStatsDelta(stats, frame["s"].toObject());
+        else continue; //cant decode deltas without a keyframe
+
+        frames.emplace_back(frame["t"].toString().toLongLong(), stats);
+    }
+    return frames;
+}
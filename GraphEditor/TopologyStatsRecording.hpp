@@ -0,0 +1,71 @@
+// Copyright (c) 2015-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <QJsonObject>
+#include <QString>
+#include <QFile>
+#include <QtGlobal>
+#include <utility>
+#include <vector>
+
+//! A single recorded stats sample: the sample time and the stats object
+typedef std::pair<qint64, QJsonObject> TopologyStatsFrame;
+
+/*!
+ * Record topology stats samples to a JSON lines file.
+ * Each line holds the sample time and only the stats values
+ * that changed since the previous line (a delta frame).
+ * Once the file exceeds the size limit it is rotated
+ * into numbered backups and the next line is a full keyframe,
+ * so that every file can be replayed on its own.
+ */
+class TopologyStatsWriter
+{
+public:
+    TopologyStatsWriter(void);
+
+    ~TopologyStatsWriter(void);
+
+    /*!
+     * Open a new recording, replacing an existing file.
+     * \param path the file path of the recording
+     * \param maxBytes rotate the file after this many bytes
+     * \param maxBackups the number of rotated files to keep
+     * \return false with an error string on failure
+     */
+    bool open(const QString &path, const qint64 maxBytes, const int maxBackups);
+
+    //! Close the current recording
+    void close(void);
+
+    bool isOpen(void) const;
+
+    //! Get the error message from the last failure
+    const QString &errorString(void) const
+    {
+        return _errorString;
+    }
+
+    //! Append a stats sample to the recording
+    bool write(const qint64 timeNs, const QJsonObject &stats);
+
+private:
+    bool rotate(void);
+    QString _path;
+    qint64 _maxBytes;
+    int _maxBackups;
+    QFile _file;
+    QJsonObject _lastStats;
+    bool _nextIsKeyframe;
+    QString _errorString;
+};
+
+/*!
+ * Load all frames from a recording made by TopologyStatsWriter.
+ * \param path the file path of the recording
+ * \param [out] errorString the error message on failure
+ * \return the frames with delta frames expanded to full stats
+ */
+std::vector<TopologyStatsFrame> loadTopologyStatsRecording(const QString &path, QString &errorString);
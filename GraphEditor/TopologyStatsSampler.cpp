@@ -0,0 +1,60 @@
+// Copyright (c) 2015-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "GraphEditor/TopologyStatsSampler.hpp"
+#include "EvalEngine/EvalEngine.hpp"
+#include <QTimer>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrent>
+#include <functional> //std::bind
+
+TopologyStatsSampler::TopologyStatsSampler(EvalEngine *evalEngine, QObject *parent):
+    QObject(parent),
+    _evalEngine(evalEngine),
+    _timer(new QTimer(this)),
+    _watcher(new QFutureWatcher<QByteArray>(this))
+{
+    _timer->setInterval(1000);
+    connect(_timer, &QTimer::timeout, this, &TopologyStatsSampler::sampleNow);
+    connect(_watcher, &QFutureWatcher<QByteArray>::finished, this, &TopologyStatsSampler::handleWatcherDone);
+}
+
+TopologyStatsSampler::~TopologyStatsSampler(void)
+{
+    _watcher->waitForFinished();
+}
+
+void TopologyStatsSampler::setEvalEngine(EvalEngine *evalEngine)
+{
+    _watcher->waitForFinished();
+    _evalEngine = evalEngine;
+}
+
+void TopologyStatsSampler::setInterval(const int intervalMs)
+{
+    _timer->setInterval(intervalMs);
+}
+
+void TopologyStatsSampler::setActive(const bool active)
+{
+    if (active) _timer->start();
+    else _timer->stop();
+}
+
+bool TopologyStatsSampler::isActive(void) const
+{
+    return _timer->isActive();
+}
+
+void TopologyStatsSampler::sampleNow(void)
+{
+    if (_evalEngine == nullptr) return;
+    if (_watcher->isRunning()) return;
+    _watcher->setFuture(QtConcurrent::run(std::bind(&EvalEngine::getTopologyJSONStats, _evalEngine)));
+}
+
+void TopologyStatsSampler::handleWatcherDone(void)
+{
+    emit this->sampleReady(_watcher->result());
+}
@@ -0,0 +1,51 @@
+// Copyright (c) 2015-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <QObject>
+#include <QByteArray>
+
+class EvalEngine;
+class QTimer;
+template <typename T> class QFutureWatcher;
+
+/*!
+ * The stats sampler periodically queries the topology JSON stats
+ * in a background thread and emits each result in the GUI thread.
+ * A new query is not started while the previous one is in progress.
+ */
+class TopologyStatsSampler : public QObject
+{
+    Q_OBJECT
+public:
+    TopologyStatsSampler(EvalEngine *evalEngine, QObject *parent);
+
+    ~TopologyStatsSampler(void);
+
+    //! Change the eval engine, waits on an outstanding query
+    void setEvalEngine(EvalEngine *evalEngine);
+
+    //! Set the sampling interval in milliseconds
+    void setInterval(const int intervalMs);
+
+    //! Start or stop periodic sampling
+    void setActive(const bool active);
+    bool isActive(void) const;
+
+public slots:
+    //! Start a single query now (ignored when one is in progress)
+    void sampleNow(void);
+
+signals:
+    //! A query completed, a null result means the topology was not available
+    void sampleReady(const QByteArray &jsonStats);
+
+private slots:
+    void handleWatcherDone(void);
+
+private:
+    EvalEngine *_evalEngine;
+    QTimer *_timer;
+    QFutureWatcher<QByteArray> *_watcher;
+};
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "GraphObjects/GraphBlockImpl.hpp"
+#include "GraphObjects/GraphStaticText.hpp"
 #include "GraphEditor/Constants.hpp"
 #include "GraphEditor/GraphDraw.hpp"
 #include "BlockTree/BlockCache.hpp"
@@ -20,6 +21,7 @@
 #include <iostream>
 #include <cassert>
 #include <algorithm> //min/max
+#include <cmath> //abs
 
 GraphBlock::GraphBlock(QObject *parent):
     GraphObject(parent),
@@ -470,7 +472,7 @@ QVariant GraphBlock::itemChange(GraphicsItemChange change, const QVariant &value
         this->markChanged();
         this->update();
     }
-    return QGraphicsItem::itemChange(change, value);
+    return GraphObject::itemChange(change, value);
 }
 
 QPainterPath GraphBlock::shape(void) const
@@ -573,15 +575,6 @@ GraphConnectableAttrs GraphBlock::getConnectableAttrs(const GraphConnectableKey
     return attrs;
 }
 
-static QStaticText makeQStaticText(const QString &s)
-{
-    QStaticText st(s);
-    QTextOption to;
-    to.setWrapMode(QTextOption::NoWrap);
-    st.setTextOption(to);
-    return st;
-}
-
 static QString getTextColor(const bool isOk, const QColor &bg)
 {
     if (isOk) return (bg.lightnessF() > 0.5)?"black":"white";
@@ -600,9 +593,10 @@ void GraphBlock::renderStaticText(void)
     //default rendering
     const QPen defaultPen(QColor(GraphObjectDefaultPenColor), GraphObjectBorderWidth);
     const QPen connectPen(QColor(ConnectModeHighlightPenColor), ConnectModeHighlightWidth);
-    _impl->inputPortsText.resize(_inputPorts.size(), QStaticText(" "));
+    const auto blankText = getCachedStaticText(" ");
+    _impl->inputPortsText.resize(_inputPorts.size(), blankText);
     _impl->inputPortsBorder.resize(_inputPorts.size(), defaultPen);
-    _impl->outputPortsText.resize(_outputPorts.size(), QStaticText(" "));
+    _impl->outputPortsText.resize(_outputPorts.size(), blankText);
     _impl->outputPortsBorder.resize(_outputPorts.size(), defaultPen);
     _impl->signalPortBorder = defaultPen;
     _impl->mainRectBorder = defaultPen;
@@ -613,7 +607,7 @@ void GraphBlock::renderStaticText(void)
     const bool connectToOutput = clickedEp.isValid() and clickedEp.getKey().isInput();
 
     //load the title text
-    _impl->titleText = makeQStaticText(QString("<span style='color:%1;font-size:%2;'><b>%3</b></span>")
+    _impl->titleText = getCachedStaticText(QString("<span style='color:%1;font-size:%2;'><b>%3</b></span>")
         .arg(getTextColor(this->getBlockErrorMsgs().isEmpty(), _impl->mainBlockColor))
         .arg(GraphBlockTitleFontSize)
         .arg(_impl->title.toHtmlEscaped()));
@@ -629,7 +623,7 @@ void GraphBlock::renderStaticText(void)
         auto propText = this->getPropertyDisplayText(_properties[i]);
         propText = metrics.elidedText(propText, Qt::ElideMiddle, GraphBlockPropMaxWidthPx);
 
-        auto text = makeQStaticText(QString("<span style='color:%1;font-size:%2;'><b>%3: </b> %4</span>")
+        auto text = getCachedStaticText(QString("<span style='color:%1;font-size:%2;'><b>%3: </b> %4</span>")
             .arg(getTextColor(this->getPropertyErrorMsg(_properties[i]).isEmpty(), _impl->mainBlockColor))
             .arg(GraphBlockPropFontSize)
             .arg(this->getPropertyName(_properties[i]).toHtmlEscaped())
@@ -645,7 +639,7 @@ void GraphBlock::renderStaticText(void)
         if (tracked and connectToInput) _impl->inputPortsBorder[i] = connectPen;
 
         if (not forceShowPortNames and not tracked) continue;
-        _impl->inputPortsText[i] = QStaticText(QString("<span style='color:%1;font-size:%2;'>%3</span>")
+        _impl->inputPortsText[i] = getCachedStaticText(QString("<span style='color:%1;font-size:%2;'>%3</span>")
             .arg(getTextColor(true, _impl->inputPortColors.at(i)))
             .arg(GraphBlockPortFontSize)
             .arg(this->getInputPortAlias(_inputPorts[i]).toHtmlEscaped()));
@@ -659,7 +653,7 @@ void GraphBlock::renderStaticText(void)
         if (tracked and connectToOutput) _impl->outputPortsBorder[i] = connectPen;
 
         if (not forceShowPortNames and not tracked) continue;
-        _impl->outputPortsText[i] = QStaticText(QString("<span style='color:%1;font-size:%2;'>%3</span>")
+        _impl->outputPortsText[i] = getCachedStaticText(QString("<span style='color:%1;font-size:%2;'>%3</span>")
             .arg(getTextColor(true, _impl->outputPortColors.at(i)))
             .arg(GraphBlockPortFontSize)
             .arg(this->getOutputPortAlias(_outputPorts[i]).toHtmlEscaped()));
@@ -697,6 +691,26 @@ static QColor generateDisabledColor(const QColor c)
     );
 }
 
+static QColor generateHeatmapColor(const QColor c, const qreal level)
+{
+    const QColor h(GraphDrawHeatmapHotColor);
+    const qreal alpha(level*GraphDrawHeatmapAlphaBlend);
+    return QColor(
+        h.red()*alpha + c.red()*(1-alpha),
+        h.green()*alpha + c.green()*(1-alpha),
+        h.blue()*alpha + c.blue()*(1-alpha)
+    );
+}
+
+void GraphBlock::setHeatmapLevel(const qreal level)
+{
+    //skip repaints for changes too small to see
+    const qreal oldLevel = _impl->heatmapLevel;
+    if ((level < 0) == (oldLevel < 0) and std::abs(level - oldLevel) < 0.01) return;
+    _impl->heatmapLevel = level;
+    this->update();
+}
+
 void GraphBlock::render(QPainter &painter)
 {
     //render text
@@ -723,6 +737,9 @@ void GraphBlock::render(QPainter &painter)
         this->scene()->update();
     }
 
+    //reduced detail skips text and curves, but keeps the layout
+    const bool lowDetail = this->draw()->isLowDetail();
+
     //setup rotations and translations
     QTransform trans;
 
@@ -805,7 +822,7 @@ void GraphBlock::render(QPainter &painter)
 
         const qreal availablePortHPad = portRect.width() - text.size().width();
         const qreal availablePortVPad = portRect.height() - text.size().height();
-        painter.drawStaticText(portRect.topLeft()+QPointF(availablePortHPad/2.0, availablePortVPad/2.0), text);
+        if (not lowDetail) painter.drawStaticText(portRect.topLeft()+QPointF(availablePortHPad/2.0, availablePortVPad/2.0), text);
 
         //connection point logic
         const auto connPoint = portRect.topLeft() + QPointF(portFlip?rectSize.width()+GraphObjectBorderWidth:-GraphObjectBorderWidth, rectSize.height()/2);
@@ -827,13 +844,14 @@ void GraphBlock::render(QPainter &painter)
         painter.save();
         painter.setBrush(QBrush(_impl->outputPortColors.at(i)));
         painter.setPen(_impl->outputPortsBorder[i]);
-        painter.drawRoundedRect(portRect, GraphBlockPortArc, GraphBlockPortArc);
+        if (lowDetail) painter.drawRect(portRect);
+        else painter.drawRoundedRect(portRect, GraphBlockPortArc, GraphBlockPortArc);
         painter.restore();
         _impl->outputPortRects[i] = trans.mapRect(portRect);
 
         const qreal availablePortHPad = portRect.width() - text.size().width() + arcFix;
         const qreal availablePortVPad = portRect.height() - text.size().height();
-        painter.drawStaticText(portRect.topLeft()+QPointF(availablePortHPad/2.0-arcFix, availablePortVPad/2.0), text);
+        if (not lowDetail) painter.drawStaticText(portRect.topLeft()+QPointF(availablePortHPad/2.0-arcFix, availablePortVPad/2.0), text);
 
         //connection point logic
         const auto connPoint = portRect.topLeft() + QPointF(portFlip?-GraphObjectBorderWidth:rectSize.width()+GraphObjectBorderWidth, rectSize.height()/2);
@@ -870,7 +888,8 @@ void GraphBlock::render(QPainter &painter)
         painter.save();
         painter.setBrush(QBrush(_impl->mainBlockColor));
         painter.setPen(_impl->signalPortBorder);
-        painter.drawRoundedRect(portRect, GraphBlockPortArc, GraphBlockPortArc);
+        if (lowDetail) painter.drawRect(portRect);
+        else painter.drawRoundedRect(portRect, GraphBlockPortArc, GraphBlockPortArc);
         painter.restore();
 
         _impl->signalPortRect = trans.mapRect(portRect);
@@ -899,11 +918,16 @@ void GraphBlock::render(QPainter &painter)
 
     //draw main body of the block
     painter.save();
-    painter.setBrush(QBrush(_impl->mainBlockColor));
+    if (_impl->heatmapLevel >= 0) painter.setBrush(QBrush(generateHeatmapColor(_impl->mainBlockColor, _impl->heatmapLevel)));
+    else painter.setBrush(QBrush(_impl->mainBlockColor));
     painter.setPen(_impl->mainRectBorder);
-    painter.drawRoundedRect(mainRect, GraphBlockMainArc, GraphBlockMainArc);
+    if (lowDetail) painter.drawRect(mainRect);
+    else painter.drawRoundedRect(mainRect, GraphBlockMainArc, GraphBlockMainArc);
     painter.restore();
 
+    //text is unreadable at this scale
+    if (lowDetail) return;
+
     //create title
     const qreal availableTitleHPad = overallWidth-_impl->titleText.size().width();
     painter.drawStaticText(p+QPointF(availableTitleHPad/2.0, GraphBlockTitleVPad), _impl->titleText);
@@ -134,6 +134,9 @@ public:
     void registerEndpoint(const GraphConnectionEndpoint &ep);
     void unregisterEndpoint(const GraphConnectionEndpoint &ep);
 
+    //! Set the live work time fraction [0, 1] for the heatmap overlay, negative to clear
+    void setHeatmapLevel(const qreal level);
+
 signals:
 
     //! Called by the evaluator when eval completed
@@ -21,7 +21,8 @@ struct GraphBlock::Impl
         signalPortUseCount(0),
         slotPortUseCount(0),
         showPortNames(false),
-        eventPortsInline(false)
+        eventPortsInline(false),
+        heatmapLevel(-1.0)
     {
         return;
     }
@@ -82,6 +83,9 @@ struct GraphBlock::Impl
     bool showPortNames;
     bool eventPortsInline;
 
+    //live stats overlay
+    qreal heatmapLevel;
+
     QRectF mainBlockRect;
     QPointer<QWidget> graphWidget;
 };
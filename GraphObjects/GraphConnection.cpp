@@ -11,6 +11,7 @@
 #include <QPainter>
 #include <QPolygonF>
 #include <QStaticText>
+#include <QFontMetricsF>
 #include <iostream>
 #include <algorithm> //std::find
 #include <cassert>
@@ -31,7 +32,9 @@ static QString directionToStr(const GraphConnectableDirection direction)
 
 struct GraphConnection::Impl
 {
-    Impl(void)
+    Impl(void):
+        routeValid(false),
+        routeLowDetail(false)
     {
         return;
     }
@@ -43,9 +46,21 @@ struct GraphConnection::Impl
 
     QStaticText lineText;
 
+    //cached route, recomputed when the endpoint attributes change
+    bool routeValid;
+    bool routeLowDetail;
+    GraphConnectableAttrs routeOutputAttrs;
+    GraphConnectableAttrs routeInputAttrs;
     QVector<QPointF> points;
+    QPainterPath path;
     QPolygonF arrowHead;
+    QTransform textTransform;
+    QPointF textTopLeft;
     QRectF textRect;
+    QPainterPath shapePath;
+
+    //live stats overlay
+    QString throughputText;
 };
 
 GraphConnection::GraphConnection(QObject *parent):
@@ -83,6 +98,7 @@ void GraphConnection::setupEndpoint(const GraphConnectionEndpoint &ep)
         graphBlock->registerEndpoint(ep);
     }
 
+    _impl->routeValid = false;
     this->markChanged();
 }
 
@@ -226,9 +242,26 @@ void GraphConnection::handleEndPointEventRecheck(void)
     if (not foundOutput or not foundInput) this->flagForDelete();
 }
 
+static QFont throughputFont(void)
+{
+    QFont font;
+    font.setPointSizeF(GraphConnectionThroughputPointSize);
+    return font;
+}
+
+void GraphConnection::setThroughputText(const QString &text)
+{
+    if (_impl->throughputText == text) return;
+    this->prepareGeometryChange();
+    _impl->throughputText = text;
+    _impl->shapePath = QPainterPath(); //label bounds changed
+    this->update();
+}
+
 QPainterPath GraphConnection::shape(void) const
 {
-    QPainterPath path;
+    if (not _impl->shapePath.isEmpty()) return _impl->shapePath;
+    auto &path = _impl->shapePath;
 
     //individual line segments
     for (int i = 1; i < _impl->points.size(); i++)
@@ -246,6 +279,13 @@ QPainterPath GraphConnection::shape(void) const
     //text
     path.addRect(_impl->textRect);
 
+    //live throughput label
+    if (not _impl->throughputText.isEmpty() and not _impl->path.isEmpty())
+    {
+        const auto textPos = _impl->path.pointAtPercent(0.5) + QPointF(GraphConnectionGirth*2, -GraphConnectionGirth*2);
+        path.addRect(QFontMetricsF(throughputFont()).boundingRect(_impl->throughputText).translated(textPos));
+    }
+
     return path;
 }
 
@@ -363,6 +403,7 @@ void GraphConnection::render(QPainter &painter)
             .arg(text));
         QTextOption to; to.setWrapMode(QTextOption::NoWrap);
         _impl->lineText.setTextOption(to);
+        _impl->routeValid = false; //text placement depends on the text size
     }
 
     //query the connectable info
@@ -371,6 +412,69 @@ void GraphConnection::render(QPainter &painter)
     auto inputAttrs = _impl->inputEp.getConnectableAttrs();
     inputAttrs.point = this->mapFromItem(_impl->inputEp.getObj(), inputAttrs.point);
 
+    //only re-route when an endpoint moved, rotated, or changed its ports
+    const bool lowDetail = this->draw()->isLowDetail();
+    if (not _impl->routeValid or
+        _impl->routeLowDetail != lowDetail or
+        _impl->routeOutputAttrs.point != outputAttrs.point or
+        _impl->routeOutputAttrs.rotation != outputAttrs.rotation or
+        _impl->routeInputAttrs.point != inputAttrs.point or
+        _impl->routeInputAttrs.rotation != inputAttrs.rotation)
+    {
+        this->updateRoute(outputAttrs, inputAttrs, lowDetail);
+    }
+
+    //draw the painter path
+    QColor color(GraphConnectionDefaultColor);
+    if (this->isSelected()) color = GraphConnectionHighlightColor;
+    else if (not this->isEnabled()) color = GraphConnectionDisabledColor;
+    painter.setBrush(Qt::NoBrush);
+    QPen pen(color);
+    pen.setWidthF(GraphConnectionGirth);
+    if (this->isSignalOrSlot()) pen.setStyle(Qt::DashLine);
+    painter.setPen(pen);
+    painter.drawPath(_impl->path);
+
+    //draw an X for disabled
+    if (not this->isEnabled())
+    {
+        painter.save();
+        const qreal len(GraphConnectionDisabledXLen/2.0);
+        QLineF line0(QPointF(+len, +len), QPointF(-len, -len));
+        QLineF line1(QPointF(-len, +len), QPointF(+len, -len));
+        painter.translate(_impl->path.pointAtPercent(0.5));
+        painter.drawLine(line0);
+        painter.drawLine(line1);
+        painter.restore();
+    }
+
+    //draw text
+    if (this->isSignalOrSlot() and not lowDetail)
+    {
+        painter.save();
+        painter.setTransform(_impl->textTransform, true);
+        painter.drawStaticText(_impl->textTopLeft, _impl->lineText);
+        painter.restore();
+    }
+
+    //draw the live throughput near the middle of the path
+    if (not _impl->throughputText.isEmpty() and not lowDetail)
+    {
+        painter.save();
+        painter.setFont(throughputFont());
+        painter.setPen(QColor(GraphConnectionThroughputTextColor));
+        painter.drawText(_impl->path.pointAtPercent(0.5) + QPointF(GraphConnectionGirth*2, -GraphConnectionGirth*2), _impl->throughputText);
+        painter.restore();
+    }
+
+    //draw arrow head
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QBrush(color));
+    painter.drawPolygon(_impl->arrowHead);
+}
+
+void GraphConnection::updateRoute(const GraphConnectableAttrs &outputAttrs, const GraphConnectableAttrs &inputAttrs, const bool lowDetail)
+{
     //make the minimal output protrusion
     const auto op0 = outputAttrs.point;
     QTransform otrans; otrans.rotate(outputAttrs.rotation);
@@ -390,6 +494,7 @@ void GraphConnection::render(QPainter &painter)
     points.push_back(ip0);
 
     //create a painter path with curves for corners
+    //reduced detail uses straight corners since curves are not visible
     QLineF largestLine;
     QPainterPath path(points.front());
     for (int i = 1; i < points.size()-1; i++)
@@ -399,40 +504,18 @@ void GraphConnection::render(QPainter &painter)
         const auto next = points[i+1];
         const QLineF line(last, curr);
         if (line.length() > largestLine.length()) largestLine = line;
+        if (lowDetail) {path.lineTo(curr); continue;}
         path.lineTo(lineShorten(line).p2());
         path.quadTo(curr, lineShorten(QLineF(next, curr)).p2());
     }
     path.lineTo(points.back());
-
-    //draw the painter path
-    QColor color(GraphConnectionDefaultColor);
-    if (this->isSelected()) color = GraphConnectionHighlightColor;
-    else if (not this->isEnabled()) color = GraphConnectionDisabledColor;
-    painter.setBrush(Qt::NoBrush);
-    QPen pen(color);
-    pen.setWidthF(GraphConnectionGirth);
-    if (this->isSignalOrSlot()) pen.setStyle(Qt::DashLine);
-    painter.setPen(pen);
-    painter.drawPath(path);
     _impl->points = points;
+    _impl->path = path;
 
-    //draw an X for disabled
-    if (not this->isEnabled())
-    {
-        painter.save();
-        const qreal len(GraphConnectionDisabledXLen/2.0);
-        QLineF line0(QPointF(+len, +len), QPointF(-len, -len));
-        QLineF line1(QPointF(-len, +len), QPointF(+len, -len));
-        painter.translate(path.pointAtPercent(0.5));
-        painter.drawLine(line0);
-        painter.drawLine(line1);
-        painter.restore();
-    }
-
-    //draw text
+    //text placement
+    _impl->textRect = QRectF();
     if (this->isSignalOrSlot())
     {
-        painter.save();
         const auto &text = _impl->lineText;
         const auto boundingRect = path.boundingRect();
 
@@ -477,13 +560,14 @@ void GraphConnection::render(QPainter &painter)
             }
         }
 
-        painter.translate(textPos);
-        painter.rotate(textAngle);
+        QTransform textTrans;
+        textTrans.translate(textPos.x(), textPos.y());
+        textTrans.rotate(textAngle);
         const auto hs = std::max(1.0, this->getSigSlotPairs().size()/std::ceil(this->getSigSlotPairs().size()/2.0));
         const QRectF textRect(QPointF(-text.size().width()/2, -text.size().height()/hs - GraphConnectionGirth), text.size());
-        painter.drawStaticText(textRect.topLeft(), text);
-        _impl->textRect = painter.worldTransform().mapRect(textRect);
-        painter.restore();
+        _impl->textTransform = textTrans;
+        _impl->textTopLeft = textRect.topLeft();
+        _impl->textRect = textTrans.mapRect(textRect);
     }
 
     //create arrow head
@@ -495,10 +579,14 @@ void GraphConnection::render(QPainter &painter)
     QPolygonF arrowHead;
     const auto tip = inputAttrs.point;
     arrowHead << tip << (tip+p0) << (tip+p1);
-    painter.setPen(Qt::NoPen);
-    painter.setBrush(QBrush(color));
-    painter.drawPolygon(arrowHead);
     _impl->arrowHead = arrowHead;
+
+    //the selection shape is rebuilt from the new route on demand
+    _impl->routeOutputAttrs = outputAttrs;
+    _impl->routeInputAttrs = inputAttrs;
+    _impl->routeLowDetail = lowDetail;
+    _impl->routeValid = true;
+    _impl->shapePath = QPainterPath();
 }
 
 /***********************************************************************
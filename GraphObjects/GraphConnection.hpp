@@ -53,6 +53,9 @@ public:
 
     QPainterPath shape(void) const;
 
+    //! Set the live throughput label for the heatmap overlay, empty to clear
+    void setThroughputText(const QString &text);
+
     void render(QPainter &painter);
 
     QJsonObject serialize(void) const;
@@ -72,6 +75,9 @@ private:
     //only called by the destructor
     void unregisterEndpoint(const GraphConnectionEndpoint &ep);
 
+    //recompute the cached path, text placement, and arrow head
+    void updateRoute(const GraphConnectableAttrs &outputAttrs, const GraphConnectableAttrs &inputAttrs, const bool lowDetail);
+
     struct Impl;
     std::unique_ptr<Impl> _impl;
 };
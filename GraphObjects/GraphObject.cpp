@@ -5,6 +5,7 @@
 #include "GraphEditor/Constants.hpp"
 #include "GraphEditor/GraphDraw.hpp"
 #include <QGraphicsSceneMouseEvent>
+#include <QGraphicsScene>
 #include <QGraphicsView>
 #include <QPainter>
 #include <cassert>
@@ -21,7 +22,8 @@ struct GraphObject::Impl
         enabled(true),
         locked(false),
         changed(true),
-        canMove(false)
+        canMove(false),
+        registeredDraw(nullptr)
     {
         return;
     }
@@ -33,6 +35,7 @@ struct GraphObject::Impl
     bool changed;
     bool canMove;
     GraphConnectableKey trackedKey;
+    GraphDraw *registeredDraw;
 };
 
 GraphObject::GraphObject(QObject *parent):
@@ -47,7 +50,40 @@ GraphObject::GraphObject(QObject *parent):
 
 GraphObject::~GraphObject(void)
 {
-    return;
+    //unregister here because itemChange() cannot be called from the base destructor
+    if (_impl->registeredDraw != nullptr) _impl->registeredDraw->unregisterGraphObject(this);
+}
+
+void GraphObject::updateRegisteredDraw(void)
+{
+    GraphDraw *newDraw = nullptr;
+    if (this->scene() != nullptr and not this->scene()->views().isEmpty())
+    {
+        newDraw = qobject_cast<GraphDraw *>(this->scene()->views().at(0));
+    }
+    if (newDraw == _impl->registeredDraw) return;
+    if (_impl->registeredDraw != nullptr) _impl->registeredDraw->unregisterGraphObject(this);
+    _impl->registeredDraw = newDraw;
+    if (_impl->registeredDraw != nullptr) _impl->registeredDraw->registerGraphObject(this);
+}
+
+void GraphObject::detachRegisteredDraw(void)
+{
+    _impl->registeredDraw = nullptr;
+}
+
+QVariant GraphObject::itemChange(GraphicsItemChange change, const QVariant &value)
+{
+    //keep the graph draw's registry in sync with scene moves and selection
+    if (change == QGraphicsItem::ItemSceneHasChanged)
+    {
+        this->updateRegisteredDraw();
+    }
+    if (change == QGraphicsItem::ItemSelectedHasChanged and _impl->registeredDraw != nullptr)
+    {
+        _impl->registeredDraw->updateGraphObjectSelection(this);
+    }
+    return QGraphicsObject::itemChange(change, value);
 }
 
 GraphDraw *GraphObject::draw(void) const
@@ -66,6 +102,7 @@ void GraphObject::setId(const QString &id)
 {
     assert(_impl);
     _impl->id = id;
+    if (_impl->registeredDraw != nullptr) _impl->registeredDraw->updateGraphObjectId(this);
     emit this->IDChanged(id);
 }
 
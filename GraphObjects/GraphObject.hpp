@@ -91,6 +91,9 @@ protected:
     void mousePressEvent(QGraphicsSceneMouseEvent *event);
     void mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event);
 
+    //! Tracks scene and selection changes in the graph draw's object registry
+    QVariant itemChange(GraphicsItemChange change, const QVariant &value);
+
     /*!
      * Called by the graph draw class to handle mouse tracking.
      * The position is relative to this graph object's reference.
@@ -101,6 +104,12 @@ protected:
 
     friend class GraphDraw;
 private:
+    //! Register with the graph draw that owns the current scene
+    void updateRegisteredDraw(void);
+
+    //! Called by the graph draw when it is destroyed before its objects
+    void detachRegisteredDraw(void);
+
     struct Impl;
     std::unique_ptr<Impl> _impl;
 };
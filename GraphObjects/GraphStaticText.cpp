@@ -0,0 +1,83 @@
+// Copyright (c) 2013-2018 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "GraphObjects/GraphStaticText.hpp"
+#include <QTextOption>
+#include <QTransform>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+
+//! Flush the cache when it gets this large (edited property values pile up)
+static const size_t StaticTextCacheMaxEntries = 4096;
+
+/***********************************************************************
+ * static text cache structures
+ **********************************************************************/
+struct StaticTextKeyHash
+{
+    size_t operator()(const std::pair<QString, QString> &key) const
+    {
+        return qHash(key.first) ^ (qHash(key.second) << 1);
+    }
+};
+
+struct StaticTextCache
+{
+    StaticTextCache(void):
+        hits(0),
+        misses(0)
+    {
+        return;
+    }
+
+    std::mutex mutex;
+    std::unordered_map<std::pair<QString, QString>, QStaticText, StaticTextKeyHash> entries;
+    size_t hits;
+    size_t misses;
+};
+
+static StaticTextCache &getStaticTextCache(void)
+{
+    static StaticTextCache cache;
+    return cache;
+}
+
+/***********************************************************************
+ * static text cache interface
+ **********************************************************************/
+QStaticText getCachedStaticText(const QString &text, const QFont &font)
+{
+    auto &cache = getStaticTextCache();
+    const auto key = std::make_pair(text, font.key());
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto it = cache.entries.find(key);
+    if (it != cache.entries.end())
+    {
+        cache.hits++;
+        return it->second;
+    }
+    cache.misses++;
+
+    //create and lay out a new entry
+    QStaticText st(text);
+    QTextOption to;
+    to.setWrapMode(QTextOption::NoWrap);
+    st.setTextOption(to);
+    st.prepare(QTransform(), font);
+
+    if (cache.entries.size() >= StaticTextCacheMaxEntries) cache.entries.clear();
+    return cache.entries.emplace(key, st).first->second;
+}
+
+StaticTextCacheStats getStaticTextCacheStats(void)
+{
+    auto &cache = getStaticTextCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    StaticTextCacheStats stats;
+    stats.hits = cache.hits;
+    stats.misses = cache.misses;
+    stats.entries = cache.entries.size();
+    return stats;
+}
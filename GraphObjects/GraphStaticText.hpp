@@ -0,0 +1,28 @@
+// Copyright (c) 2013-2018 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <QStaticText>
+#include <QString>
+#include <QFont>
+#include <cstddef>
+
+/*!
+ * Get a prepared static text for the rich text string.
+ * Identical labels share one layout through a process-wide cache
+ * keyed by the text (which includes the inline style) and the font.
+ * The returned copy is implicitly shared with the cached entry.
+ */
+QStaticText getCachedStaticText(const QString &text, const QFont &font = QFont());
+
+//! Usage counters for the static text cache
+struct StaticTextCacheStats
+{
+    size_t hits;
+    size_t misses;
+    size_t entries;
+};
+
+//! Get a snapshot of the static text cache counters
+StaticTextCacheStats getStaticTextCacheStats(void);
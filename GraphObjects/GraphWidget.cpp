@@ -116,7 +116,7 @@ QVariant GraphWidget::itemChange(GraphicsItemChange change, const QVariant &valu
         _impl->container->setSelected(this->isSelected());
     }
 
-    return QGraphicsItem::itemChange(change, value);
+    return GraphObject::itemChange(change, value);
 }
 
 void GraphWidget::handleBlockEvalDone(void)
@@ -0,0 +1,120 @@
+// Copyright (c) 2013-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "HostExplorer/HostLoadMonitor.hpp"
+#include "HostExplorer/RemoteEnvironmentPool.hpp"
+#include "MainWindow/MainSettings.hpp"
+#include <Pothos/Remote.hpp>
+#include <Pothos/Proxy.hpp>
+#include <QWidget>
+#include <QTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrent>
+#include <functional> //std::bind
+#include <algorithm> //min/max
+
+static const int DEFAULT_SAMPLE_INTERVAL_MS = 2000;
+
+/***********************************************************************
+ * load aquisition
+ **********************************************************************/
+static HostLoad sampleHostLoad(const QString &uri)
+{
+    HostLoad load;
+    load.uri = uri;
+    Pothos::ProxyEnvironment::Sptr env;
+    try
+    {
+        env = RemoteEnvironmentPool::global().getEnvironment(uri);
+        load.numaInfo = env->findProxy("Pothos/System/NumaInfo").call<std::vector<Pothos::System::NumaInfo>>("get");
+        load.valid = true;
+    }
+    catch (const Pothos::Exception &)
+    {
+        RemoteEnvironmentPool::global().invalidate(uri);
+        return load;
+    }
+
+    //the system load module may not be installed on this host
+    try
+    {
+        const std::string loadJson = env->findProxy("Pothos/Flow/SystemLoad").call("dumpJson");
+        const auto obj = QJsonDocument::fromJson(QByteArray(loadJson.data(), int(loadJson.size()))).object();
+        for (const auto &value : obj["loadAverage"].toArray())
+        {
+            load.loadAverage.push_back(value.toDouble());
+        }
+        for (const auto &value : obj["cpus"].toArray())
+        {
+            const auto cpuObj = value.toObject();
+            load.cpuTimes[size_t(cpuObj["cpu"].toInt())] = std::make_pair(cpuObj["total"].toDouble(), cpuObj["idle"].toDouble());
+        }
+    }
+    catch (const Pothos::Exception &){}
+    return load;
+}
+
+/***********************************************************************
+ * load monitor implementation
+ **********************************************************************/
+HostLoadMonitor::HostLoadMonitor(QWidget *parent):
+    QObject(parent),
+    _widget(parent),
+    _timer(new QTimer(this)),
+    _watcher(new QFutureWatcher<HostLoad>(this))
+{
+    connect(_timer, &QTimer::timeout, this, &HostLoadMonitor::sampleNow);
+    connect(_watcher, &QFutureWatcher<HostLoad>::finished, this, &HostLoadMonitor::handleWatcherDone);
+}
+
+HostLoadMonitor::~HostLoadMonitor(void)
+{
+    _watcher->waitForFinished();
+}
+
+void HostLoadMonitor::setUri(const QString &uri)
+{
+    if (_uri != uri) _lastCpuTimes.clear();
+    _uri = uri;
+    const int intervalMs = MainSettings::global()->value("HostExplorer/loadSampleIntervalMs", DEFAULT_SAMPLE_INTERVAL_MS).toInt();
+    if (_uri.isEmpty() or intervalMs <= 0)
+    {
+        _timer->stop();
+        return;
+    }
+    _timer->start(intervalMs);
+    this->sampleNow();
+}
+
+void HostLoadMonitor::sampleNow(void)
+{
+    if (_uri.isEmpty()) return;
+    if (not _widget->isVisible()) return;
+    if (_watcher->isRunning()) return;
+    _watcher->setFuture(QtConcurrent::run(std::bind(&sampleHostLoad, _uri)));
+}
+
+void HostLoadMonitor::handleWatcherDone(void)
+{
+    //drop a sample for the previously monitored host
+    auto load = _watcher->result();
+    if (load.uri != _uri) return;
+
+    //utilization over the interval since this monitor's last sample,
+    //clamped because the idle time can go backwards (iowait on Linux)
+    for (const auto &pair : load.cpuTimes)
+    {
+        auto it = _lastCpuTimes.find(pair.first);
+        if (it == _lastCpuTimes.end()) continue;
+        const double total = pair.second.first - it->second.first;
+        const double idle = pair.second.second - it->second.second;
+        if (total <= 0.0) continue;
+        load.cpuUsage[pair.first] = std::min(std::max(1.0 - idle/total, 0.0), 1.0);
+    }
+    _lastCpuTimes = load.cpuTimes;
+    emit this->loadSampled(load);
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2013-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <Pothos/System/NumaInfo.hpp>
+#include <QObject>
+#include <QString>
+#include <utility>
+#include <vector>
+#include <map>
+
+class QWidget;
+class QTimer;
+template <typename T> class QFutureWatcher;
+
+//! One sample of the live load on a host
+struct HostLoad
+{
+    HostLoad(void):
+        valid(false)
+    {}
+    QString uri;
+    bool valid; //!< false when the host could not be reached
+    std::vector<double> loadAverage; //!< 1, 5, and 15 minute averages, empty when unknown
+    std::map<size_t, double> cpuUsage; //!< CPU number to utilization from 0.0 to 1.0
+    std::vector<Pothos::System::NumaInfo> numaInfo; //!< per-node total and free memory
+    std::map<size_t, std::pair<double, double>> cpuTimes; //!< CPU number to raw total and idle ticks
+};
+
+/*!
+ * The load monitor periodically samples the live load of one host
+ * in a background thread and emits each result in the GUI thread.
+ * Samples are only taken while the widget that displays them is visible,
+ * and a new sample is not started while the previous one is in progress.
+ *
+ * Per-node memory comes from the NUMA info query.
+ * Per-core utilization and load averages come from the flow system load
+ * module, hosts without the module only report memory.
+ * Utilization is the change in CPU times between this monitor's samples.
+ * The interval is the "HostExplorer/loadSampleIntervalMs" setting.
+ */
+class HostLoadMonitor : public QObject
+{
+    Q_OBJECT
+public:
+    HostLoadMonitor(QWidget *parent);
+
+    ~HostLoadMonitor(void);
+
+    //! Monitor this host, an empty URI stops the monitor
+    void setUri(const QString &uri);
+
+signals:
+    void loadSampled(const HostLoad &load);
+
+private slots:
+    void sampleNow(void);
+    void handleWatcherDone(void);
+
+private:
+    QWidget *_widget;
+    QString _uri;
+    QTimer *_timer;
+    QFutureWatcher<HostLoad> *_watcher;
+    std::map<size_t, std::pair<double, double>> _lastCpuTimes;
+};
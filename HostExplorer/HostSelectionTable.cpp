@@ -12,45 +12,77 @@
 #include <QToolTip>
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QThreadPool>
 #include <QtConcurrent/QtConcurrent>
+#include "HostExplorer/RemoteEnvironmentPool.hpp"
 #include <Pothos/Remote.hpp>
 #include <Pothos/Proxy.hpp>
 #include <Pothos/System.hpp>
 #include <Pothos/Util/Network.hpp>
 #include <map>
+#include <chrono>
+#include <cmath> //fabs
 #include <iostream>
-#include <functional> //std::bind
+
+//! Timeout to connect to each host, hosts are probed in parallel
+static const long PROBE_TIMEOUT_US = 1000000;
+
+//! The jitter estimate moves by this fraction of each new deviation
+static const double JITTER_GAIN = 1.0/16;
+
+//! Save the last access time at this granularity rather than every probe
+static const int LAST_ACCESS_SAVE_SECS = 60;
 
 /***********************************************************************
  * NodeInfo update implementation
  **********************************************************************/
 void NodeInfo::update(void)
 {
-    auto settings = MainSettings::global();
-    //determine if the host is online and update access times
+    auto &pool = RemoteEnvironmentPool::global();
+
+    //determine if the host is online and update access times,
+    //otherwise the name and access time from the last probe remain
     try
     {
-        Pothos::RemoteClient client(this->uri.toStdString());
+        //the latency is always the time to connect a new client,
+        //so that every sample and the jitter measure the same thing;
+        //the connection closes after the probe, so probing does not
+        //keep an environment open on every listed host
+        const auto t0 = std::chrono::steady_clock::now();
+        Pothos::RemoteClient client(this->uri.toStdString(), PROBE_TIMEOUT_US);
+        const auto t1 = std::chrono::steady_clock::now();
+        const double connectMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        if (this->latencyMs >= 0.0) this->jitterMs += (std::fabs(connectMs - this->latencyMs) - this->jitterMs)*JITTER_GAIN;
+        this->latencyMs = connectMs;
+
+        //drop a pooled environment that stopped answering,
+        //the views that use it reconnect on their next access
+        auto env = pool.findEnvironment(this->uri);
+        if (env) try
+        {
+            env->findProxy("Pothos/System/HostInfo");
+        }
+        catch (const Pothos::Exception &)
+        {
+            pool.invalidate(this->uri);
+            env.reset();
+        }
+
         if (this->nodeName.isEmpty())
         {
-            auto env = client.makeEnvironment("managed");
+            if (not env) env = client.makeEnvironment("managed");
             Pothos::System::HostInfo hostInfo = env->findProxy("Pothos/System/HostInfo").call("get");
             this->nodeName = QString::fromStdString(hostInfo.nodeName);
-            settings->setValue("HostExplorer/"+this->uri+"/nodeName", this->nodeName);
         }
         this->isOnline = true;
         this->lastAccess = QDateTime::currentDateTime();
-        settings->setValue("HostExplorer/"+this->uri+"/lastAccess", this->lastAccess);
     }
-    //otherwise, fetch the information from the settings cache
-    catch(const Pothos::RemoteClientError &)
+    catch(const Pothos::Exception &)
     {
+        pool.invalidate(this->uri);
         this->isOnline = false;
-        if (this->nodeName.isEmpty())
-        {
-            this->nodeName = settings->value("HostExplorer/"+this->uri+"/nodeName").toString();
-        }
-        this->lastAccess = settings->value("HostExplorer/"+this->uri+"/lastAccess").toDateTime();
+        this->latencyMs = -1.0;
+        this->jitterMs = 0.0;
     }
 }
 
@@ -170,7 +202,8 @@ HostSelectionTable::HostSelectionTable(QWidget *parent):
     _addButton(makeToolButton(this, "list-add")),
     _removeMapper(new QSignalMapper(this)),
     _timer(new QTimer(this)),
-    _watcher(new QFutureWatcher<std::vector<NodeInfo>>(this))
+    _probeMapper(new QSignalMapper(this)),
+    _probePool(new QThreadPool(this))
 {
     this->setColumnCount(nCols);
     size_t col = 0;
@@ -178,6 +211,8 @@ HostSelectionTable::HostSelectionTable(QWidget *parent):
     this->setHorizontalHeaderItem(col++, new QTableWidgetItem(tr("URI")));
     this->setHorizontalHeaderItem(col++, new QTableWidgetItem(tr("Name")));
     this->setHorizontalHeaderItem(col++, new QTableWidgetItem(tr("Last Access")));
+    this->setHorizontalHeaderItem(col++, new QTableWidgetItem(tr("Latency")));
+    this->setHorizontalHeaderItem(col++, new QTableWidgetItem(tr("Jitter")));
 
     //create the data entry row
     this->setRowCount(1);
@@ -190,7 +225,7 @@ HostSelectionTable::HostSelectionTable(QWidget *parent):
     connect(_lineEdit, &HostUriQLineEdit::handleUriEntered, this, &HostSelectionTable::handleAdd);
     connect(_removeMapper, SIGNAL(mapped(const QString &)), this, SLOT(handleRemove(const QString &)));
     connect(_timer, &QTimer::timeout, this, &HostSelectionTable::handleUpdateStatus);
-    connect(_watcher, SIGNAL(finished(void)), this, SLOT(handleNodeQueryComplete(void)));
+    connect(_probeMapper, SIGNAL(mapped(const QString &)), this, SLOT(handleNodeQueryResult(const QString &)));
     connect(this, SIGNAL(cellClicked(int, int)), this, SLOT(handleCellClicked(int, int)));
 
     this->reloadTable();
@@ -208,8 +243,9 @@ void HostSelectionTable::handleCellClicked(const int row, const int col)
     for (const auto &entry : _uriToRow)
     {
         if (entry.second != size_t(row)) continue;
-        auto &info = _uriToInfo.at(entry.first);
+        auto info = _uriToInfo.at(entry.first);
         info.update();
+        this->reloadRows(std::vector<NodeInfo>(1, info));
         if (info.isOnline) emit hostInfoRequest(info.uri.toStdString());
         else this->showErrorMessage(tr("Host %1 is offline").arg(info.uri));
     }
@@ -252,9 +288,10 @@ void HostSelectionTable::handleAdd(const QString &uri)
     }
 }
 
-void HostSelectionTable::handleNodeQueryComplete(void)
+void HostSelectionTable::handleNodeQueryResult(const QString &uri)
 {
-    this->reloadRows(_watcher->result());
+    //each host is shown as soon as its probe completes
+    this->reloadRows(std::vector<NodeInfo>(1, _uriToWatcher.at(uri)->result()));
 }
 
 void HostSelectionTable::handleUpdateStatus(void)
@@ -277,13 +314,30 @@ void HostSelectionTable::handleUpdateStatus(void)
         nodes.push_back(entry.second);
     }
     this->reloadRows(nodes); //initial load, future will fill in the rest
-    _watcher->setFuture(QtConcurrent::run(std::bind(&HostSelectionTable::peformNodeComms, nodes)));
+
+    //one thread per host, so a stalled host never delays the others
+    _probePool->setMaxThreadCount(std::max<int>(_probePool->maxThreadCount(), nodes.size()));
+    for (const auto &node : nodes)
+    {
+        auto &watcher = _uriToWatcher[node.uri];
+        if (watcher == nullptr)
+        {
+            watcher = new QFutureWatcher<NodeInfo>(this);
+            connect(watcher, SIGNAL(finished(void)), _probeMapper, SLOT(map()));
+            _probeMapper->setMapping(watcher, node.uri);
+        }
+
+        //this host is still being probed from the last round, skip it
+        if (watcher->isRunning()) continue;
+        watcher->setFuture(QtConcurrent::run(_probePool, std::bind(&HostSelectionTable::probeNode, node)));
+    }
 }
 
-std::vector<NodeInfo> HostSelectionTable::peformNodeComms(std::vector<NodeInfo> nodes)
+NodeInfo HostSelectionTable::probeNode(const NodeInfo &node)
 {
-    for (size_t i = 0; i < nodes.size(); i++) nodes[i].update();
-    return nodes;
+    NodeInfo result(node);
+    result.update();
+    return result;
 }
 
 void HostSelectionTable::reloadRows(const std::vector<NodeInfo> &nodeInfos)
@@ -294,6 +348,7 @@ void HostSelectionTable::reloadRows(const std::vector<NodeInfo> &nodeInfos)
         if (_uriToRow.find(info.uri) == _uriToRow.end()) continue;
         const size_t row = _uriToRow[info.uri];
         _uriToInfo[info.uri] = info;
+        this->saveNodeInfo(info);
 
         //gather information
         const auto timeStr = info.lastAccess.toString("h:mm:ss AP - MMM d yyyy");
@@ -306,21 +361,52 @@ void HostSelectionTable::reloadRows(const std::vector<NodeInfo> &nodeInfos)
         this->setItem(row, col++, new QTableWidgetItem(statusIcon, info.uri));
         this->setItem(row, col++, new QTableWidgetItem(info.nodeName));
         this->setItem(row, col++, new QTableWidgetItem(accessTimeStr));
+        const bool hasLatency = info.isOnline and info.latencyMs >= 0.0;
+        this->setItem(row, col++, new QTableWidgetItem(hasLatency?tr("%1 ms").arg(info.latencyMs, 0, 'f', 1):QString()));
+        this->setItem(row, col++, new QTableWidgetItem(hasLatency?tr("%1 ms").arg(info.jitterMs, 0, 'f', 1):QString()));
         for (size_t c = 0; c < nCols; c++) disableEdit(this->item(row, c));
     }
     this->resizeColumnsToContents();
 }
 
+void HostSelectionTable::saveNodeInfo(const NodeInfo &info)
+{
+    //settings are written to disk, so only write what changed
+    auto settings = MainSettings::global();
+    auto &saved = _uriToSavedInfo[info.uri];
+    if (not info.nodeName.isEmpty() and info.nodeName != saved.nodeName)
+    {
+        settings->setValue("HostExplorer/"+info.uri+"/nodeName", info.nodeName);
+        saved.nodeName = info.nodeName;
+    }
+    if (info.lastAccess.isValid() and (not saved.lastAccess.isValid() or
+        saved.lastAccess.secsTo(info.lastAccess) >= LAST_ACCESS_SAVE_SECS))
+    {
+        settings->setValue("HostExplorer/"+info.uri+"/lastAccess", info.lastAccess);
+        saved.lastAccess = info.lastAccess;
+    }
+}
+
 void HostSelectionTable::reloadTable(void)
 {
     int row = 1;
     _uriToRow.clear();
 
     //enumerate the available hosts
+    auto settings = MainSettings::global();
     for (const auto &uri : getHostUriList())
     {
         this->setRowCount(row+1);
-        _uriToInfo[uri].uri = uri;
+
+        //new hosts start with the name and access time from the last session
+        if (_uriToInfo.count(uri) == 0)
+        {
+            auto &info = _uriToInfo[uri];
+            info.uri = uri;
+            info.nodeName = settings->value("HostExplorer/"+uri+"/nodeName").toString();
+            info.lastAccess = settings->value("HostExplorer/"+uri+"/lastAccess").toDateTime();
+            _uriToSavedInfo[uri] = info;
+        }
         _uriToRow[uri] = row;
         auto removeButton = makeToolButton(this, "list-remove");
         this->setCellWidget(row, 0, removeButton);
@@ -13,19 +13,25 @@
 class HostUriQLineEdit;
 class QToolButton;
 class QSignalMapper;
+class QThreadPool;
 class QTimer;
 
 //! information stored about a node
 struct NodeInfo
 {
     NodeInfo(void):
-        isOnline(false)
+        isOnline(false),
+        latencyMs(-1.0),
+        jitterMs(0.0)
     {}
     QString uri;
     bool isOnline;
     QDateTime lastAccess;
     QString nodeName;
+    double latencyMs; //!< last time to connect, negative when unknown
+    double jitterMs; //!< smoothed variation between connect times
 
+    //! Probe the host, safe to call from any thread (no settings access)
     void update(void);
 };
 
@@ -55,23 +61,27 @@ private slots:
 
     void handleAdd(const QString &uri);
 
-    void handleNodeQueryComplete(void);
+    void handleNodeQueryResult(const QString &uri);
 
     void handleUpdateStatus(void);
 
 private:
 
-    static std::vector<NodeInfo> peformNodeComms(std::vector<NodeInfo> nodes);
+    static NodeInfo probeNode(const NodeInfo &node);
 
     void reloadRows(const std::vector<NodeInfo> &nodes);
+    void saveNodeInfo(const NodeInfo &info);
     void reloadTable(void);
     void showErrorMessage(const QString &errMsg);
     HostUriQLineEdit *_lineEdit;
     QToolButton *_addButton;
     QSignalMapper *_removeMapper;
     QTimer *_timer;
-    QFutureWatcher<std::vector<NodeInfo>> *_watcher;
+    QSignalMapper *_probeMapper;
+    QThreadPool *_probePool; //!< dedicated to probes, apart from other background jobs
+    std::map<QString, QFutureWatcher<NodeInfo> *> _uriToWatcher; //!< one probe in flight per host
     std::map<QString, size_t> _uriToRow;
     std::map<QString, NodeInfo> _uriToInfo;
-    static const size_t nCols = 4;
+    std::map<QString, NodeInfo> _uriToSavedInfo; //last values written to the settings
+    static const size_t nCols = 6;
 };
@@ -2,14 +2,14 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "HostExplorer/PluginModuleTree.hpp"
+#include "HostExplorer/RemoteEnvironmentPool.hpp"
 #include <Pothos/System/Version.hpp> //POTHOS_API_VERSION
-#include <Pothos/Remote.hpp>
-#include <Pothos/Proxy.hpp>
-#include <Pothos/Plugin.hpp>
+#include <QAbstractItemModel>
 #include <QFuture>
 #include <QFutureWatcher>
 #include <QtConcurrent/QtConcurrent>
 #include <Poco/Logger.h>
+#include <vector>
 #include <map>
 #include <functional> //std::bind
 
@@ -18,59 +18,175 @@
 #endif
 
 /***********************************************************************
- * recursive algorithm to create widget information
+ * recursive algorithm to group plugins by module
  **********************************************************************/
-static void loadModuleMap(PluginModuleTree::ModInfoType &info, const Pothos::PluginRegistryInfoDump &dump)
+struct ModuleInfo
+{
+    QString name;
+    QString version;
+    std::vector<const std::string *> pluginPaths;
+};
+
+static void loadModuleMap(std::map<std::string, ModuleInfo> &modules, const Pothos::PluginRegistryInfoDump &dump)
 {
     if (not dump.objectType.empty())
     {
-        info.modMap[dump.modulePath].push_back(dump.pluginPath);
+        auto &module = modules[dump.modulePath];
+        module.pluginPaths.push_back(&dump.pluginPath);
         #ifdef HAS_MODULE_VERSION
-        info.modVers[dump.modulePath] = dump.moduleVersion;
+        module.version = QString::fromStdString(dump.moduleVersion);
         #endif
     }
 
     for (const auto &subInfo : dump.subInfo)
     {
-        loadModuleMap(info, subInfo);
+        loadModuleMap(modules, subInfo);
     }
 }
 
+/***********************************************************************
+ * lazy item model of modules and their plugin paths
+ * module rows have an internal id of 0, plugin path rows
+ * have an internal id of their module's row plus one
+ **********************************************************************/
+class PluginModuleModel : public QAbstractItemModel
+{
+public:
+    PluginModuleModel(QObject *parent):
+        QAbstractItemModel(parent)
+    {
+        return;
+    }
+
+    const PluginRegistryCache::DumpSptr &dump(void) const
+    {
+        return _dump;
+    }
+
+    void setDump(const PluginRegistryCache::DumpSptr &dump)
+    {
+        this->beginResetModel();
+        _dump = dump;
+        _modules.clear();
+        if (_dump)
+        {
+            std::map<std::string, ModuleInfo> modules;
+            loadModuleMap(modules, *_dump);
+            for (auto &entry : modules)
+            {
+                entry.second.name = QString::fromStdString(entry.first.empty()?"Builtin":entry.first);
+                _modules.push_back(entry.second);
+            }
+        }
+        this->endResetModel();
+    }
+
+    size_t numPlugins(const int row) const
+    {
+        return _modules.at(row).pluginPaths.size();
+    }
+
+    QModelIndex index(int row, int column, const QModelIndex &parent) const
+    {
+        if (row < 0) return QModelIndex();
+        if (not parent.isValid())
+        {
+            if (size_t(row) >= _modules.size()) return QModelIndex();
+            return this->createIndex(row, column, quintptr(0));
+        }
+        if (parent.internalId() != 0) return QModelIndex();
+        if (size_t(row) >= _modules[parent.row()].pluginPaths.size()) return QModelIndex();
+        return this->createIndex(row, column, quintptr(parent.row()+1));
+    }
+
+    QModelIndex parent(const QModelIndex &index) const
+    {
+        if (not index.isValid() or index.internalId() == 0) return QModelIndex();
+        return this->createIndex(int(index.internalId()-1), 0, quintptr(0));
+    }
+
+    int rowCount(const QModelIndex &parent) const
+    {
+        if (not parent.isValid()) return int(_modules.size());
+        if (parent.internalId() != 0 or parent.column() != 0) return 0;
+        return int(_modules[parent.row()].pluginPaths.size());
+    }
+
+    int columnCount(const QModelIndex &) const
+    {
+        #ifdef HAS_MODULE_VERSION
+        return 3;
+        #else
+        return 2;
+        #endif
+    }
+
+    QVariant data(const QModelIndex &index, int role) const
+    {
+        if (not index.isValid() or role != Qt::DisplayRole) return QVariant();
+        if (index.internalId() != 0)
+        {
+            if (index.column() != 0) return QVariant();
+            const auto &module = _modules[index.internalId()-1];
+            return QString::fromStdString(*module.pluginPaths[index.row()]);
+        }
+        const auto &module = _modules[index.row()];
+        switch (index.column())
+        {
+        case 0: return module.name;
+        case 1: return QString("%1").arg(module.pluginPaths.size());
+        case 2: return module.version;
+        default: return QVariant();
+        }
+    }
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const
+    {
+        if (orientation != Qt::Horizontal or role != Qt::DisplayRole) return QVariant();
+        switch (section)
+        {
+        case 0: return PluginModuleTree::tr("Plugin Path");
+        case 1: return PluginModuleTree::tr("Count");
+        case 2: return PluginModuleTree::tr("Version");
+        default: return QVariant();
+        }
+    }
+
+private:
+    //the plugin paths point into the dump
+    PluginRegistryCache::DumpSptr _dump;
+    std::vector<ModuleInfo> _modules;
+};
+
 /***********************************************************************
  * information aquisition
  **********************************************************************/
-static PluginModuleTree::ModInfoType getRegistryDump(const std::string &uriStr)
+static PluginRegistryCache::DumpSptr getRegistryDump(const std::string &uriStr)
 {
-    PluginModuleTree::ModInfoType info;
     try
     {
-        auto env = Pothos::RemoteClient(uriStr).makeEnvironment("managed");
-        const Pothos::PluginRegistryInfoDump dump = env->findProxy("Pothos/PluginRegistry").call("dump");
-        loadModuleMap(info, dump);
+        return PluginRegistryCache::global().get(QString::fromStdString(uriStr));
     }
     catch (const Pothos::Exception &ex)
     {
         static auto &logger = Poco::Logger::get("PothosFlow.PluginModuleTree");
+        RemoteEnvironmentPool::global().invalidate(QString::fromStdString(uriStr));
+        PluginRegistryCache::global().invalidate(QString::fromStdString(uriStr));
         logger.error("Failed to dump registry %s - %s", uriStr, ex.displayText());
     }
-    return info;
+    return PluginRegistryCache::DumpSptr();
 }
 
 /***********************************************************************
- * plugin module tree widget
+ * plugin module tree view
  **********************************************************************/
 PluginModuleTree::PluginModuleTree(QWidget *parent):
-    QTreeWidget(parent),
-    _watcher(new QFutureWatcher<ModInfoType>(this))
+    QTreeView(parent),
+    _watcher(new QFutureWatcher<PluginRegistryCache::DumpSptr>(this)),
+    _model(new PluginModuleModel(this))
 {
-    QStringList columnNames;
-    columnNames.push_back(tr("Plugin Path"));
-    columnNames.push_back(tr("Count"));
-    #ifdef HAS_MODULE_VERSION
-    columnNames.push_back(tr("Version"));
-    #endif
-    this->setColumnCount(columnNames.size());
-    this->setHeaderLabels(columnNames);
+    this->setModel(_model);
+    this->setUniformRowHeights(true);
 
     connect(
         _watcher, SIGNAL(finished(void)),
@@ -80,35 +196,30 @@ PluginModuleTree::PluginModuleTree(QWidget *parent):
 void PluginModuleTree::handeInfoRequest(const std::string &uriStr)
 {
     if (_watcher->isRunning()) return;
-    while (this->topLevelItemCount() > 0) delete this->topLevelItem(0);
+
+    //show the cached dump now, the query checks that it is still current
+    this->setDump(PluginRegistryCache::global().lookup(QString::fromStdString(uriStr)));
     _watcher->setFuture(QtConcurrent::run(std::bind(&getRegistryDump, uriStr)));
     emit startLoad();
 }
 
 void PluginModuleTree::handleWatcherDone(void)
 {
-    const auto info = _watcher->result();
+    this->setDump(_watcher->result());
+    emit stopLoad();
+}
+
+void PluginModuleTree::setDump(const PluginRegistryCache::DumpSptr &dump)
+{
+    //an unchanged dump keeps the expanded rows
+    if (dump == _model->dump()) return;
+    _model->setDump(dump);
 
-    for (const auto &entry : info.modMap)
+    //small modules are expanded, their few rows are cheap to create
+    for (int row = 0; row < _model->rowCount(QModelIndex()); row++)
     {
-        std::string name = entry.first;
-        if (name.empty()) name = "Builtin";
-        const auto &pluginPaths = entry.second;
-        QStringList columns;
-        columns.push_back(QString::fromStdString(name));
-        columns.push_back(QString("%1").arg(pluginPaths.size()));
-        #ifdef HAS_MODULE_VERSION
-        columns.push_back(QString::fromStdString(info.modVers.at(entry.first)));
-        #endif
-        auto modRoot = new QTreeWidgetItem(this, columns);
-        modRoot->setExpanded(pluginPaths.size() < 21);
-        for (size_t i = 0; i < pluginPaths.size(); i++)
-        {
-            new QTreeWidgetItem(modRoot, QStringList(QString::fromStdString(pluginPaths[i])));
-        }
+        if (_model->numPlugins(row) < 21) this->expand(_model->index(row, 0, QModelIndex()));
     }
-
-    for (int i = 0; i < this->columnCount(); i++)
+    for (int i = 0; i < _model->columnCount(QModelIndex()); i++)
         this->resizeColumnToContents(i);
-    emit stopLoad();
 }
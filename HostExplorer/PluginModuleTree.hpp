@@ -3,25 +3,24 @@
 
 #pragma once
 #include <Pothos/Config.hpp>
-#include <QTreeWidget>
+#include "HostExplorer/PluginRegistryCache.hpp"
+#include <QTreeView>
 #include <QFutureWatcher>
-#include <map>
-#include <vector>
 #include <string>
 
-//! tree widget display for a host's loaded modules
-class PluginModuleTree : public QTreeWidget
+class PluginModuleModel;
+
+/*!
+ * Tree view display for a host's loaded modules.
+ * Modules are grouped from the cached registry dump,
+ * and plugin path items are only created for expanded modules.
+ */
+class PluginModuleTree : public QTreeView
 {
     Q_OBJECT
 public:
     PluginModuleTree(QWidget *parent);
 
-    struct ModInfoType
-    {
-        std::map<std::string, std::vector<std::string>> modMap;
-        std::map<std::string, std::string> modVers;
-    };
-
 signals:
     void startLoad(void);
     void stopLoad(void);
@@ -34,5 +33,7 @@ private slots:
     void handleWatcherDone(void);
 
 private:
-    QFutureWatcher<ModInfoType> *_watcher;
+    void setDump(const PluginRegistryCache::DumpSptr &dump);
+    QFutureWatcher<PluginRegistryCache::DumpSptr> *_watcher;
+    PluginModuleModel *_model;
 };
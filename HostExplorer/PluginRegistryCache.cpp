@@ -0,0 +1,102 @@
+// Copyright (c) 2013-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "HostExplorer/PluginRegistryCache.hpp"
+#include "HostExplorer/RemoteEnvironmentPool.hpp"
+#include <Pothos/Remote.hpp>
+#include <Pothos/Proxy.hpp>
+#include <Pothos/System/Version.hpp> //POTHOS_API_VERSION
+
+#if POTHOS_API_VERSION >= 0x00070000
+#define HAS_MODULE_VERSION
+#endif
+
+static bool isSameDump(const Pothos::PluginRegistryInfoDump &a, const Pothos::PluginRegistryInfoDump &b)
+{
+    if (a.pluginPath != b.pluginPath) return false;
+    if (a.objectType != b.objectType) return false;
+    if (a.modulePath != b.modulePath) return false;
+    #ifdef HAS_MODULE_VERSION
+    if (a.moduleVersion != b.moduleVersion) return false;
+    #endif
+    if (a.subInfo.size() != b.subInfo.size()) return false;
+    for (size_t i = 0; i < a.subInfo.size(); i++)
+    {
+        if (not isSameDump(a.subInfo[i], b.subInfo[i])) return false;
+    }
+    return true;
+}
+
+PluginRegistryCache &PluginRegistryCache::global(void)
+{
+    static PluginRegistryCache cache;
+    return cache;
+}
+
+PluginRegistryCache::DumpSptr PluginRegistryCache::lookup(const QString &uri) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _entries.find(uri);
+    if (it == _entries.end()) return DumpSptr();
+    return it->second.dump;
+}
+
+PluginRegistryCache::DumpSptr PluginRegistryCache::get(const QString &uri, const bool refresh)
+{
+    //the unique process id identifies the server, a restart gets a new id
+    auto env = RemoteEnvironmentPool::global().getEnvironment(uri);
+    const auto upid = env->getUniquePid();
+
+    //wait on another dump in progress, then check for a valid entry
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto &entry = _entries[uri];
+    _cond.wait(lock, [&entry]{return not entry.loading;});
+    if (not refresh and entry.dump and entry.upid == upid) return entry.dump;
+    entry.loading = true;
+    lock.unlock();
+
+    //dump the registry outside of the lock
+    DumpSptr dump;
+    try
+    {
+        dump = std::make_shared<Pothos::PluginRegistryInfoDump>(
+            env->findProxy("Pothos/PluginRegistry").call<Pothos::PluginRegistryInfoDump>("dump"));
+    }
+    catch (const Pothos::Exception &)
+    {
+        lock.lock();
+        entry.loading = false;
+        _cond.notify_all();
+        throw;
+    }
+
+    //keep the cached pointer when nothing changed,
+    //the trees compare by pointer to skip reloading their models
+    lock.lock();
+    if (entry.dump and isSameDump(*entry.dump, *dump)) dump = entry.dump;
+    entry.upid = upid;
+    entry.dump = dump;
+    entry.loading = false;
+    _cond.notify_all();
+    return dump;
+}
+
+void PluginRegistryCache::invalidate(const QString &uri)
+{
+    //entries are not erased, a dump in progress holds a reference
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _entries.find(uri);
+    if (it == _entries.end()) return;
+    it->second.upid.clear();
+    it->second.dump.reset();
+}
+
+void PluginRegistryCache::clear(void)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto &pair : _entries)
+    {
+        pair.second.upid.clear();
+        pair.second.dump.reset();
+    }
+}
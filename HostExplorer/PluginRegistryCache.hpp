@@ -0,0 +1,63 @@
+// Copyright (c) 2013-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <Pothos/Plugin/Registry.hpp>
+#include <QString>
+#include <condition_variable>
+#include <memory>
+#include <string>
+#include <mutex>
+#include <map>
+
+/*!
+ * A thread-safe cache of plugin registry dumps keyed by host URI.
+ * The registry and module trees share one dump per host.
+ * A dump is reused until the host's server process changes,
+ * which is when a different set of modules can be loaded.
+ * Concurrent requests for the same host wait on a single dump.
+ */
+class PluginRegistryCache
+{
+public:
+    typedef std::shared_ptr<const Pothos::PluginRegistryInfoDump> DumpSptr;
+
+    //! Get access to the global cache
+    static PluginRegistryCache &global(void);
+
+    //! Get the cached dump without contacting the host, null when not cached
+    DumpSptr lookup(const QString &uri) const;
+
+    /*!
+     * Get the dump for the host, only dumping the registry again
+     * when the host's server process changed since the cached dump.
+     * This call blocks on the host, call it from a background thread.
+     * \throws Pothos::Exception when the host cannot be reached
+     * \param uri the URI of the host's remote server
+     * \param refresh true to always dump the registry and update the cache
+     */
+    DumpSptr get(const QString &uri, const bool refresh = false);
+
+    //! Drop the host's dump after a failed call, the next get dumps again
+    void invalidate(const QString &uri);
+
+    //! Drop all dumps, used when the servers restart
+    void clear(void);
+
+private:
+    PluginRegistryCache(void){}
+
+    struct Entry
+    {
+        Entry(void):
+            loading(false){}
+        std::string upid;
+        DumpSptr dump;
+        bool loading;
+    };
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cond;
+    std::map<QString, Entry> _entries;
+};
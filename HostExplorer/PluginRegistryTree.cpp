@@ -2,81 +2,159 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "HostExplorer/PluginRegistryTree.hpp"
-#include <Pothos/Remote.hpp>
-#include <Pothos/Proxy.hpp>
+#include "HostExplorer/RemoteEnvironmentPool.hpp"
 #include <Pothos/Plugin.hpp>
+#include <QAbstractItemModel>
 #include <QFuture>
 #include <QFutureWatcher>
 #include <QtConcurrent/QtConcurrent>
 #include <Poco/Logger.h>
-#include <iostream>
+#include <unordered_map>
+#include <functional> //std::bind
 
 /***********************************************************************
- * recursive tree widget item convert dump into tree
+ * lazy item model over a registry dump
  **********************************************************************/
-class PluginPathTreeItem : public QTreeWidgetItem
+class PluginRegistryModel : public QAbstractItemModel
 {
 public:
-    template <typename Parent>
-    PluginPathTreeItem(Parent *parent, const Pothos::PluginRegistryInfoDump &dump):
-        QTreeWidgetItem(parent, columnsFromDump(dump))
+    typedef Pothos::PluginRegistryInfoDump Dump;
+
+    PluginRegistryModel(QObject *parent):
+        QAbstractItemModel(parent)
+    {
+        return;
+    }
+
+    const PluginRegistryCache::DumpSptr &dump(void) const
+    {
+        return _dump;
+    }
+
+    void setDump(const PluginRegistryCache::DumpSptr &dump)
+    {
+        this->beginResetModel();
+        _dump = dump;
+        _parents.clear();
+        this->endResetModel();
+    }
+
+    QModelIndex index(int row, int column, const QModelIndex &parent) const
     {
-        for (const auto &subInfo : dump.subInfo)
+        if (not _dump or row < 0) return QModelIndex();
+
+        //the single top level row is the registry root
+        if (not parent.isValid())
         {
-            new PluginPathTreeItem(this, subInfo);
+            if (row != 0) return QModelIndex();
+            return this->createIndex(row, column, const_cast<Dump *>(_dump.get()));
         }
-        this->setExpanded(dump.subInfo.size() < 21); //auto expand if not too many items
+
+        //children are only indexed when the view asks for them
+        const auto node = nodeOf(parent);
+        if (size_t(row) >= node->subInfo.size()) return QModelIndex();
+        const auto child = &node->subInfo[row];
+        _parents[child] = node;
+        return this->createIndex(row, column, const_cast<Dump *>(child));
     }
 
-private:
-    static QStringList columnsFromDump(const Pothos::PluginRegistryInfoDump &dump)
+    QModelIndex parent(const QModelIndex &index) const
+    {
+        if (not index.isValid()) return QModelIndex();
+        const auto it = _parents.find(nodeOf(index));
+        if (it == _parents.end()) return QModelIndex(); //the root
+        const auto parentNode = it->second;
+
+        //the row of the parent is its offset in the grandparent's list
+        const auto grandIt = _parents.find(parentNode);
+        const int row = (grandIt == _parents.end())?0:int(parentNode - grandIt->second->subInfo.data());
+        return this->createIndex(row, 0, const_cast<Dump *>(parentNode));
+    }
+
+    int rowCount(const QModelIndex &parent) const
+    {
+        if (not _dump) return 0;
+        if (not parent.isValid()) return 1;
+        if (parent.column() != 0) return 0;
+        return int(nodeOf(parent)->subInfo.size());
+    }
+
+    int columnCount(const QModelIndex &) const
     {
-        QStringList columns;
-        auto nodes = Pothos::PluginPath(dump.pluginPath).listNodes();
+        return 3;
+    }
 
-        if (nodes.empty()) columns.push_back("/");
-        else columns.push_back(QString::fromStdString(nodes.back()));
+    QVariant data(const QModelIndex &index, int role) const
+    {
+        if (not index.isValid() or role != Qt::DisplayRole) return QVariant();
+        const auto node = nodeOf(index);
+        switch (index.column())
+        {
+        case 0:
+        {
+            const auto nodes = Pothos::PluginPath(node->pluginPath).listNodes();
+            if (nodes.empty()) return QString("/");
+            return QString::fromStdString(nodes.back());
+        }
+        case 1: return QString::fromStdString(node->objectType);
+        case 2: return QString::fromStdString(node->modulePath);
+        default: return QVariant();
+        }
+    }
 
-        if (not dump.objectType.empty())
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const
+    {
+        if (orientation != Qt::Horizontal or role != Qt::DisplayRole) return QVariant();
+        switch (section)
         {
-            columns.push_back(QString::fromStdString(dump.objectType));
-            columns.push_back(QString::fromStdString(dump.modulePath));
+        case 0: return PluginRegistryTree::tr("Plugin path");
+        case 1: return PluginRegistryTree::tr("Object type");
+        case 2: return PluginRegistryTree::tr("Module path");
+        default: return QVariant();
         }
-        return columns;
     }
+
+private:
+    static const Dump *nodeOf(const QModelIndex &index)
+    {
+        return static_cast<const Dump *>(index.internalPointer());
+    }
+
+    PluginRegistryCache::DumpSptr _dump;
+
+    //parent of every node indexed so far
+    mutable std::unordered_map<const Dump *, const Dump *> _parents;
 };
 
 /***********************************************************************
  * information aquisition
  **********************************************************************/
-static Pothos::PluginRegistryInfoDump getRegistryDump(const std::string &uriStr)
+static PluginRegistryCache::DumpSptr getRegistryDump(const std::string &uriStr)
 {
     try
     {
-        auto env = Pothos::RemoteClient(uriStr).makeEnvironment("managed");
-        return env->findProxy("Pothos/PluginRegistry").call("dump");
+        return PluginRegistryCache::global().get(QString::fromStdString(uriStr));
     }
     catch (const Pothos::Exception &ex)
     {
+        RemoteEnvironmentPool::global().invalidate(QString::fromStdString(uriStr));
+        PluginRegistryCache::global().invalidate(QString::fromStdString(uriStr));
         static auto &logger = Poco::Logger::get("PothosFlow.PluginRegistryTree");
         logger.error("Failed to dump registry %s - %s", uriStr, ex.displayText());
     }
-    return Pothos::PluginRegistryInfoDump();
+    return PluginRegistryCache::DumpSptr();
 }
 
 /***********************************************************************
- * tree widget plugin registry implementation
+ * tree view plugin registry implementation
  **********************************************************************/
 PluginRegistryTree::PluginRegistryTree(QWidget *parent):
-    QTreeWidget(parent),
-    _watcher(new QFutureWatcher<Pothos::PluginRegistryInfoDump>(this))
+    QTreeView(parent),
+    _watcher(new QFutureWatcher<PluginRegistryCache::DumpSptr>(this)),
+    _model(new PluginRegistryModel(this))
 {
-    QStringList columnNames;
-    columnNames.push_back(tr("Plugin path"));
-    columnNames.push_back(tr("Object type"));
-    columnNames.push_back(tr("Module path"));
-    this->setColumnCount(columnNames.size());
-    this->setHeaderLabels(columnNames);
+    this->setModel(_model);
+    this->setUniformRowHeights(true);
 
     connect(
         _watcher, SIGNAL(finished(void)),
@@ -86,15 +164,26 @@ PluginRegistryTree::PluginRegistryTree(QWidget *parent):
 void PluginRegistryTree::handeInfoRequest(const std::string &uriStr)
 {
     if (_watcher->isRunning()) return;
-    while (this->topLevelItemCount() > 0) delete this->topLevelItem(0);
+
+    //show the cached dump now, the query checks that it is still current
+    this->setDump(PluginRegistryCache::global().lookup(QString::fromStdString(uriStr)));
     _watcher->setFuture(QtConcurrent::run(std::bind(&getRegistryDump, uriStr)));
     emit startLoad();
 }
 
 void PluginRegistryTree::handleWatcherDone(void)
 {
-    new PluginPathTreeItem(this, _watcher->result());
+    this->setDump(_watcher->result());
+    emit stopLoad();
+}
+
+void PluginRegistryTree::setDump(const PluginRegistryCache::DumpSptr &dump)
+{
+    //an unchanged dump keeps the expanded rows
+    if (dump == _model->dump()) return;
+    _model->setDump(dump);
+    if (not dump) return;
+    this->expand(_model->index(0, 0, QModelIndex()));
     this->resizeColumnToContents(0);
     this->resizeColumnToContents(1);
-    emit stopLoad();
 }
@@ -3,13 +3,19 @@
 
 #pragma once
 #include <Pothos/Config.hpp>
-#include <QTreeWidget>
+#include "HostExplorer/PluginRegistryCache.hpp"
+#include <QTreeView>
 #include <QFutureWatcher>
-#include <Pothos/Plugin/Registry.hpp>
 #include <string>
 
-//! tree widget display for a host's plugin registry
-class PluginRegistryTree : public QTreeWidget
+class PluginRegistryModel;
+
+/*!
+ * Tree view display for a host's plugin registry.
+ * The model reads the cached registry dump directly,
+ * so items are only created for the rows that the view expands.
+ */
+class PluginRegistryTree : public QTreeView
 {
     Q_OBJECT
 public:
@@ -27,5 +33,7 @@ private slots:
     void handleWatcherDone(void);
 
 private:
-    QFutureWatcher<Pothos::PluginRegistryInfoDump> *_watcher;
+    void setDump(const PluginRegistryCache::DumpSptr &dump);
+    QFutureWatcher<PluginRegistryCache::DumpSptr> *_watcher;
+    PluginRegistryModel *_model;
 };
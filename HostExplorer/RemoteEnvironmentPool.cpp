@@ -0,0 +1,124 @@
+// Copyright (c) 2013-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "HostExplorer/RemoteEnvironmentPool.hpp"
+#include <Poco/Logger.h>
+
+//! Health check entries that were not used for this long before reuse
+static const qint64 HEALTH_CHECK_IDLE_MS = 5000;
+
+//! Drop entries that were not used for this long
+static const qint64 EVICT_IDLE_MS = 120000;
+
+RemoteEnvironmentPool &RemoteEnvironmentPool::global(void)
+{
+    static RemoteEnvironmentPool pool;
+    return pool;
+}
+
+RemoteEnvironmentPool::RemoteEnvironmentPool(void)
+{
+    _stats.hits = 0;
+    _stats.misses = 0;
+    _stats.evictions = 0;
+    _stats.entries = 0;
+    _clock.start();
+}
+
+Pothos::ProxyEnvironment::Sptr RemoteEnvironmentPool::getEnvironment(const QString &uri, const long timeoutUs)
+{
+    static auto &logger = Poco::Logger::get("PothosFlow.RemoteEnvironmentPool");
+
+    //look for a live entry
+    Pothos::ProxyEnvironment::Sptr env;
+    bool needsCheck = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto nowMs = _clock.elapsed();
+        this->evictIdle(nowMs);
+        auto it = _entries.find(uri);
+        if (it != _entries.end())
+        {
+            env = it->second.env;
+            needsCheck = (nowMs - it->second.lastUsedMs) > HEALTH_CHECK_IDLE_MS;
+            it->second.lastUsedMs = nowMs;
+        }
+    }
+
+    //a cheap round trip tells if the connection is still alive,
+    //checked outside of the lock so other hosts are not blocked
+    if (env and needsCheck) try
+    {
+        env->findProxy("Pothos/System/HostInfo");
+    }
+    catch (const Pothos::Exception &ex)
+    {
+        logger.debug("Stale environment %s - %s", uri.toStdString(), ex.displayText());
+        this->invalidate(uri);
+        env.reset();
+    }
+
+    if (env)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stats.hits++;
+        return env;
+    }
+
+    //connect without the lock held, this can take up to the timeout
+    Entry entry;
+    entry.client = Pothos::RemoteClient(uri.toStdString(), timeoutUs);
+    entry.env = entry.client.makeEnvironment("managed");
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats.misses++;
+    entry.lastUsedMs = _clock.elapsed();
+
+    //another thread may have connected in the meantime, prefer the first
+    auto it = _entries.find(uri);
+    if (it == _entries.end()) it = _entries.emplace(uri, entry).first;
+    _stats.entries = _entries.size();
+    return it->second.env;
+}
+
+Pothos::ProxyEnvironment::Sptr RemoteEnvironmentPool::findEnvironment(const QString &uri) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _entries.find(uri);
+    if (it == _entries.end()) return Pothos::ProxyEnvironment::Sptr();
+    return it->second.env;
+}
+
+void RemoteEnvironmentPool::invalidate(const QString &uri)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.erase(uri);
+    _stats.entries = _entries.size();
+}
+
+void RemoteEnvironmentPool::clear(void)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+    _stats.entries = 0;
+}
+
+RemoteEnvironmentPool::Stats RemoteEnvironmentPool::getStats(void) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+void RemoteEnvironmentPool::evictIdle(const qint64 nowMs)
+{
+    for (auto it = _entries.begin(); it != _entries.end();)
+    {
+        if ((nowMs - it->second.lastUsedMs) < EVICT_IDLE_MS) ++it;
+        else
+        {
+            it = _entries.erase(it);
+            _stats.evictions++;
+        }
+    }
+    _stats.entries = _entries.size();
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2013-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <Pothos/Remote.hpp>
+#include <Pothos/Proxy.hpp>
+#include <QString>
+#include <QElapsedTimer>
+#include <cstddef>
+#include <mutex>
+#include <map>
+
+/*!
+ * A thread-safe pool of managed proxy environments keyed by host URI.
+ * Queries about a host reuse the connection and environment
+ * from previous queries rather than reconnecting every time.
+ * An entry that has been idle for a while is health checked
+ * before it is handed out again, and dropped when stale.
+ */
+class RemoteEnvironmentPool
+{
+public:
+
+    //! Get access to the global pool
+    static RemoteEnvironmentPool &global(void);
+
+    struct Stats
+    {
+        size_t hits;
+        size_t misses;
+        size_t evictions;
+        size_t entries;
+    };
+
+    /*!
+     * Get a managed environment for the host, connecting on a miss.
+     * \throws Pothos::Exception when the host cannot be reached
+     * \param uri the URI of the host's remote server
+     * \param timeoutUs the connection timeout for new connections
+     */
+    Pothos::ProxyEnvironment::Sptr getEnvironment(const QString &uri, const long timeoutUs = 1000000);
+
+    /*!
+     * Get the host's pooled environment without connecting or health checking.
+     * This does not count as a use, so the entry can still be evicted when idle.
+     * \return the environment or null when the host is not in the pool
+     */
+    Pothos::ProxyEnvironment::Sptr findEnvironment(const QString &uri) const;
+
+    //! Drop the host's environment after a failed call, the next get reconnects
+    void invalidate(const QString &uri);
+
+    //! Drop all environments, used when the servers restart
+    void clear(void);
+
+    //! Get the hit, miss, and eviction counters
+    Stats getStats(void) const;
+
+private:
+    RemoteEnvironmentPool(void);
+
+    struct Entry
+    {
+        Pothos::RemoteClient client;
+        Pothos::ProxyEnvironment::Sptr env;
+        qint64 lastUsedMs;
+    };
+
+    void evictIdle(const qint64 nowMs);
+
+    mutable std::mutex _mutex;
+    std::map<QString, Entry> _entries;
+    QElapsedTimer _clock;
+    Stats _stats;
+};
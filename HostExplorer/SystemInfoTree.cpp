@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "HostExplorer/SystemInfoTree.hpp"
+#include "HostExplorer/RemoteEnvironmentPool.hpp"
+#include "HostExplorer/HostLoadMonitor.hpp"
 #include <Pothos/Remote.hpp>
 #include <Pothos/Proxy.hpp>
 #include <Pothos/System.hpp>
@@ -21,7 +23,7 @@ static InfoResult getInfo(const std::string &uriStr)
     InfoResult info;
     POTHOS_EXCEPTION_TRY
     {
-        auto env = Pothos::RemoteClient(uriStr).makeEnvironment("managed");
+        auto env = RemoteEnvironmentPool::global().getEnvironment(QString::fromStdString(uriStr));
         info.hostInfo = env->findProxy("Pothos/System/HostInfo").call("get");
         info.numaInfo = env->findProxy("Pothos/System/NumaInfo").call<std::vector<Pothos::System::NumaInfo>>("get");
         const std::string deviceInfo = env->findProxy("Pothos/Util/DeviceInfoUtils").call("dumpJson");
@@ -36,6 +38,7 @@ static InfoResult getInfo(const std::string &uriStr)
     }
     POTHOS_EXCEPTION_CATCH(const Pothos::Exception &ex)
     {
+        RemoteEnvironmentPool::global().invalidate(QString::fromStdString(uriStr));
         logger.error("Failed to query system info %s - %s", uriStr, ex.displayText());
     }
     return info;
@@ -46,7 +49,9 @@ static InfoResult getInfo(const std::string &uriStr)
  **********************************************************************/
 SystemInfoTree::SystemInfoTree(QWidget *parent):
     QTreeWidget(parent),
-    _watcher(new QFutureWatcher<InfoResult>(this))
+    _watcher(new QFutureWatcher<InfoResult>(this)),
+    _loadMonitor(new HostLoadMonitor(this)),
+    _loadItem(nullptr)
 {
     QStringList columnNames;
     columnNames.push_back(tr("Name"));
@@ -58,13 +63,16 @@ SystemInfoTree::SystemInfoTree(QWidget *parent):
     connect(
         _watcher, SIGNAL(finished(void)),
         this, SLOT(handleWatcherDone(void)));
+    connect(_loadMonitor, &HostLoadMonitor::loadSampled, this, &SystemInfoTree::handleLoadSampled);
 }
 
 void SystemInfoTree::handeInfoRequest(const std::string &uriStr)
 {
     if (_watcher->isRunning()) return;
     while (this->topLevelItemCount() > 0) delete this->topLevelItem(0);
+    _loadItem = nullptr;
     _watcher->setFuture(QtConcurrent::run(std::bind(&getInfo, uriStr)));
+    _loadMonitor->setUri(QString::fromStdString(uriStr));
     emit startLoad();
 }
 
@@ -117,3 +125,39 @@ void SystemInfoTree::handleWatcherDone(void)
     this->resizeColumnToContents(2);
     emit stopLoad();
 }
+
+void SystemInfoTree::handleLoadSampled(const HostLoad &load)
+{
+    if (not load.valid) return;
+
+    //the live load is the first item, its entries are replaced every sample
+    if (_loadItem == nullptr)
+    {
+        QStringList columns;
+        columns.push_back(tr("Live Load"));
+        _loadItem = new QTreeWidgetItem(columns);
+        this->insertTopLevelItem(0, _loadItem);
+        _loadItem->setExpanded(true);
+    }
+    qDeleteAll(_loadItem->takeChildren());
+
+    if (not load.loadAverage.empty())
+    {
+        QStringList loadStrs;
+        for (const auto value : load.loadAverage) loadStrs.push_back(QString::number(value, 'f', 2));
+        makeEntry(_loadItem, "Load Average", loadStrs.join(", "), "1, 5, 15 min");
+    }
+
+    for (const auto &numaInfo : load.numaInfo)
+    {
+        if (numaInfo.totalMemory == 0) continue;
+        const auto usedMemory = numaInfo.totalMemory - numaInfo.freeMemory;
+        makeEntry(_loadItem, QString("NUMA Node %1 Memory Used").arg(numaInfo.nodeNumber),
+            QString("%1 / %2").arg(usedMemory/1024/1024).arg(numaInfo.totalMemory/1024/1024), "MB");
+    }
+
+    for (const auto &pair : load.cpuUsage)
+    {
+        makeEntry(_loadItem, QString("CPU %1 Utilization").arg(pair.first), QString::number(pair.second*100, 'f', 1), "%");
+    }
+}
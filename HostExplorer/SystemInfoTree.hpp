@@ -3,6 +3,7 @@
 
 #pragma once
 #include <Pothos/Config.hpp>
+#include "HostExplorer/HostLoadMonitor.hpp"
 #include <QTreeWidget>
 #include <QFutureWatcher>
 #include <QTreeWidgetItem>
@@ -37,6 +38,8 @@ private slots:
 
     void handleWatcherDone(void);
 
+    void handleLoadSampled(const HostLoad &load);
+
 private:
 
     template <typename Parent>
@@ -92,4 +95,6 @@ private:
     }
 
     QFutureWatcher<InfoResult> *_watcher;
+    HostLoadMonitor *_loadMonitor;
+    QTreeWidgetItem *_loadItem;
 };
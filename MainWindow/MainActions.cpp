@@ -128,6 +128,10 @@ MainActions::MainActions(QObject *parent):
 
     showTopologyStatsAction = new QAction(tr("Show topology stats dump"), this);
 
+    showBottleneckHeatmapAction = new QAction(tr("Show bottleneck heatmap"), this);
+    showBottleneckHeatmapAction->setCheckable(true);
+    showBottleneckHeatmapAction->setStatusTip(tr("Tint blocks by work time and label connections with throughput"));
+
     activateTopologyAction = new QAction(makeIconFromTheme("run-build"), tr("&Activate topology"), this);
     activateTopologyAction->setCheckable(true);
     activateTopologyAction->setShortcut(QKeySequence("F6"));
@@ -144,6 +148,10 @@ MainActions::MainActions(QObject *parent):
     clickConnectModeAction->setCheckable(true);
     clickConnectModeAction->setStatusTip(tr("Connect ports using subsequent mouse clicks"));
 
+    shareEnvironmentsAction = new QAction(tr("Share environments across designs"), this);
+    shareEnvironmentsAction->setCheckable(true);
+    shareEnvironmentsAction->setStatusTip(tr("Designs on the same host and process share one server process, its logs are labeled by host and process"));
+
     showAboutAction = new QAction(makeIconFromTheme("help-about"), tr("&About Pothos"), this);
     showAboutAction->setStatusTip(tr("Information about this version of Pothos"));
 
@@ -58,10 +58,12 @@ public:
     QAction *showGraphBoundingBoxesAction;
     QAction *showRenderedGraphAction;
     QAction *showTopologyStatsAction;
+    QAction *showBottleneckHeatmapAction;
     QAction *activateTopologyAction;
     QAction *showPortNamesAction;
     QAction *eventPortsInlineAction;
     QAction *clickConnectModeAction;
+    QAction *shareEnvironmentsAction;
     QAction *showColorsDialogAction;
     QAction *incrementAction;
     QAction *decrementAction;
@@ -74,6 +74,7 @@ MainMenu::MainMenu(QMainWindow *parent, MainActions *actions):
     executeMenu->addAction(actions->activateTopologyAction);
     executeMenu->addAction(actions->showRenderedGraphAction);
     executeMenu->addAction(actions->showTopologyStatsAction);
+    executeMenu->addAction(actions->showBottleneckHeatmapAction);
     executeMenu->addAction(actions->reloadPluginsAction);
 
     viewMenu = parent->menuBar()->addMenu(tr("&View"));
@@ -90,6 +91,7 @@ MainMenu::MainMenu(QMainWindow *parent, MainActions *actions):
     configMenu->addAction(actions->showPortNamesAction);
     configMenu->addAction(actions->eventPortsInlineAction);
     configMenu->addAction(actions->clickConnectModeAction);
+    configMenu->addAction(actions->shareEnvironmentsAction);
 
     debugMenu = toolsMenu->addMenu(tr("&Debug"));
     debugMenu->addAction(actions->showGraphConnectionPointsAction);
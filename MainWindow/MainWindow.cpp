@@ -12,6 +12,8 @@
 #include "GraphEditor/GraphEditorTabs.hpp"
 #include "GraphEditor/GraphActionsDock.hpp"
 #include "HostExplorer/HostExplorerDock.hpp"
+#include "HostExplorer/RemoteEnvironmentPool.hpp"
+#include "HostExplorer/PluginRegistryCache.hpp"
 #include "AffinitySupport/AffinityZonesDock.hpp"
 #include "MessageWindow/MessageWindowDock.hpp"
 #include "ColorUtils/ColorsDialog.hpp"
@@ -20,6 +22,7 @@
 #include "MainWindow/MainToolBar.hpp"
 #include "MainWindow/MainSettings.hpp"
 #include "MainWindow/MainSplash.hpp"
+#include "EvalEngine/EnvironmentRegistry.hpp"
 #include <QCloseEvent>
 #include <QMenuBar>
 #include <QMessageBox>
@@ -129,6 +132,10 @@ MainWindow::MainWindow(QWidget *parent):
     _actions->clickConnectModeAction->setChecked(_settings->value("MainWindow/clickConnectMode", false).toBool());
     _actions->showGraphConnectionPointsAction->setChecked(_settings->value("MainWindow/showGraphConnectionPoints", false).toBool());
     _actions->showGraphBoundingBoxesAction->setChecked(_settings->value("MainWindow/showGraphBoundingBoxes", false).toBool());
+    _actions->showBottleneckHeatmapAction->setChecked(_settings->value("MainWindow/showBottleneckHeatmap", false).toBool());
+    _actions->shareEnvironmentsAction->setChecked(_settings->value("MainWindow/shareEnvironments", false).toBool());
+    this->handleShareEnvironmentsAction(_actions->shareEnvironmentsAction->isChecked()); //before the editors load
+    connect(_actions->shareEnvironmentsAction, &QAction::toggled, this, &MainWindow::handleShareEnvironmentsAction);
 
     //finish view menu after docks and tool bars (view menu calls their toggleViewAction())
     auto viewMenu = mainMenu->viewMenu;
@@ -156,6 +163,8 @@ MainWindow::~MainWindow(void)
     _settings->setValue("MainWindow/clickConnectMode", _actions->clickConnectModeAction->isChecked());
     _settings->setValue("MainWindow/showGraphConnectionPoints", _actions->showGraphConnectionPointsAction->isChecked());
     _settings->setValue("MainWindow/showGraphBoundingBoxes", _actions->showGraphBoundingBoxesAction->isChecked());
+    _settings->setValue("MainWindow/showBottleneckHeatmap", _actions->showBottleneckHeatmapAction->isChecked());
+    _settings->setValue("MainWindow/shareEnvironments", _actions->shareEnvironmentsAction->isChecked());
 
     //close any open properties panel editor window
     _propertiesPanel->launchEditor(nullptr);
@@ -165,6 +174,10 @@ MainWindow::~MainWindow(void)
     _logger.information("Shutdown graph editor");
     delete _editorTabs;
 
+    //release pooled connections while the server and plugins are still up
+    RemoteEnvironmentPool::global().clear();
+    PluginRegistryCache::global().clear();
+
     //unload the plugins
     //increase the log level to avoid deinit verbose
     _logger.information("Unload Pothos plugins");
@@ -211,6 +224,13 @@ void MainWindow::handleColorsDialogAction(void)
     delete dialog;
 }
 
+void MainWindow::handleShareEnvironmentsAction(const bool toggle)
+{
+    //applies to environments made after the change,
+    //running designs keep their environments until re-created
+    EnvironmentRegistry::global().setEnabled(toggle);
+}
+
 void MainWindow::handleFullScreenViewAction(const bool toggle)
 {
     //gather a list of widgets to show/hide
@@ -253,6 +273,10 @@ void MainWindow::handleReloadPlugins(void)
     //clear the block cache
     _blockCache->clear();
 
+    //drop pooled environments before they are left pointing at the old server
+    RemoteEnvironmentPool::global().clear();
+    PluginRegistryCache::global().clear();
+
     //restart the local server
     this->setupServer();
 
@@ -47,6 +47,7 @@ private slots:
     void handleShowAboutQt(void);
     void handleColorsDialogAction(void);
     void handleFullScreenViewAction(const bool);
+    void handleShareEnvironmentsAction(const bool);
     void handleReloadPlugins(void);
 
 protected:
@@ -0,0 +1,104 @@
+// Copyright (c) 2013-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <utility>
+
+/*!
+ * A bounded multi-producer multi-consumer ring buffer.
+ * Each cell carries a sequence number that tells producers and consumers
+ * whose turn it is, so a push or pop only contends on a single atomic.
+ * A push on a full buffer fails immediately rather than blocking,
+ * so a logging thread is never held up by a slow consumer.
+ */
+template <typename T>
+class LogRingBuffer
+{
+public:
+    //! Create a ring buffer, the capacity is rounded up to a power of two
+    LogRingBuffer(const size_t capacity):
+        _mask(roundUpPow2(capacity)-1),
+        _cells(new Cell[_mask+1]),
+        _enqueuePos(0),
+        _dequeuePos(0)
+    {
+        for (size_t i = 0; i <= _mask; i++) _cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    //! The number of elements this buffer can hold
+    size_t capacity(void) const
+    {
+        return _mask+1;
+    }
+
+    //! Push an element, false when the buffer is full
+    bool push(const T &elem)
+    {
+        Cell *cell = nullptr;
+        size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &_cells[pos & _mask];
+            const size_t seq = cell->seq.load(std::memory_order_acquire);
+            const auto diff = ptrdiff_t(seq) - ptrdiff_t(pos);
+            if (diff == 0)
+            {
+                if (_enqueuePos.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0) return false; //full
+            else pos = _enqueuePos.load(std::memory_order_relaxed);
+        }
+        cell->data = elem;
+        cell->seq.store(pos+1, std::memory_order_release);
+        return true;
+    }
+
+    //! Pop the oldest element, false when the buffer is empty
+    bool pop(T &elem)
+    {
+        Cell *cell = nullptr;
+        size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &_cells[pos & _mask];
+            const size_t seq = cell->seq.load(std::memory_order_acquire);
+            const auto diff = ptrdiff_t(seq) - ptrdiff_t(pos+1);
+            if (diff == 0)
+            {
+                if (_dequeuePos.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0) return false; //empty
+            else pos = _dequeuePos.load(std::memory_order_relaxed);
+        }
+        elem = std::move(cell->data);
+        cell->seq.store(pos+_mask+1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static size_t roundUpPow2(const size_t n)
+    {
+        size_t pow2 = 2;
+        while (pow2 < n) pow2 <<= 1;
+        return pow2;
+    }
+
+    struct Cell
+    {
+        std::atomic<size_t> seq;
+        T data;
+    };
+
+    const size_t _mask;
+    std::unique_ptr<Cell[]> _cells;
+
+    //pad the producer and consumer positions onto separate cache lines
+    char _pad0[64];
+    std::atomic<size_t> _enqueuePos;
+    char _pad1[64];
+    std::atomic<size_t> _dequeuePos;
+};
@@ -0,0 +1,425 @@
+// Copyright (c) 2013-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "MessageWindow/LoggerArchive.hpp"
+#include <Poco/Logger.h>
+#include <QDataStream>
+#include <QFileInfo>
+#include <QDir>
+#include <QLockFile>
+#include <algorithm> //min/max/reverse
+#include <chrono>
+#include <limits>
+
+//! Seal a block after this many records
+static const quint32 BLOCK_MAX_RECORDS = 256;
+
+//! Seal a block that was open this long, so that it becomes searchable
+static const long BLOCK_SEAL_MS = 1000;
+
+//! Drop messages past this many waiting on a stalled writer
+static const size_t MAX_QUEUE_MSGS = 100000;
+
+static const QDataStream::Version STREAM_VERSION = QDataStream::Qt_5_0;
+
+//! Other running instances archive into numbered subdirectories, up to this many
+static const int MAX_INSTANCE_DIRS = 16;
+
+/***********************************************************************
+ * record and index encoding
+ **********************************************************************/
+static QByteArray encodeRecord(const Poco::Message &msg)
+{
+    QByteArray buff;
+    QDataStream out(&buff, QIODevice::WriteOnly);
+    out.setVersion(STREAM_VERSION);
+    out << qint64(msg.getTime().epochMicroseconds())
+        << quint8(msg.getPriority())
+        << QByteArray::fromStdString(msg.getSource())
+        << QByteArray::fromStdString(msg.getText());
+    return buff;
+}
+
+static bool decodeRecord(QDataStream &in, LoggerArchiveRecord &record)
+{
+    qint64 timeUs(0);
+    quint8 priority(0);
+    QByteArray source, text;
+    in >> timeUs >> priority >> source >> text;
+    if (in.status() != QDataStream::Ok) return false;
+    record.timeUs = timeUs;
+    record.priority = priority;
+    record.source = QString::fromUtf8(source);
+    record.text = QString::fromUtf8(text);
+    return true;
+}
+
+template <typename BlockType>
+static void writeBlockIndex(QIODevice &device, const BlockType &block)
+{
+    QDataStream out(&device);
+    out.setVersion(STREAM_VERSION);
+    out << block.firstTimeUs << block.lastTimeUs << block.offset << block.bytes << block.count << block.sources;
+}
+
+template <typename BlockType>
+static bool readBlockIndex(QDataStream &in, BlockType &block)
+{
+    in >> block.firstTimeUs >> block.lastTimeUs >> block.offset >> block.bytes >> block.count >> block.sources;
+    return in.status() == QDataStream::Ok;
+}
+
+static QString segmentPath(const QString &dirPath, const quint64 number, const QString &ext)
+{
+    return QDir(dirPath).absoluteFilePath(QString("%1.%2").arg(number, 10, 10, QChar('0')).arg(ext));
+}
+
+/***********************************************************************
+ * archive setup
+ **********************************************************************/
+LoggerArchiveQuery::LoggerArchiveQuery(void):
+    maxPriority(Poco::Message::PRIO_TRACE),
+    beginTimeUs(std::numeric_limits<qint64>::min()),
+    endTimeUs(std::numeric_limits<qint64>::max()),
+    older(true),
+    limit(1000)
+{
+    return;
+}
+
+LoggerArchive::LoggerArchive(const QString &dirPath, const qint64 segmentBytes, const size_t maxSegments):
+    _dirPath(dirPath),
+    _segmentBytes(segmentBytes),
+    _maxSegments(std::max<size_t>(maxSegments, 1)),
+    _openBlockStartMs(0),
+    _done(false)
+{
+    static auto &logger = Poco::Logger::get("PothosFlow.LoggerArchive");
+
+    //each running instance owns one directory, so that instances
+    //never truncate or rotate away the segments of another instance
+    for (int i = 0; i <= MAX_INSTANCE_DIRS; i++)
+    {
+        const auto path = (i == 0)?dirPath:QDir(dirPath).absoluteFilePath(QString("instance%1").arg(i));
+        QDir().mkpath(path);
+        std::unique_ptr<QLockFile> lockFile(new QLockFile(QDir(path).absoluteFilePath("archive.lock")));
+        if (not lockFile->tryLock(0)) continue;
+        _dirPath = path;
+        _lockFile = std::move(lockFile);
+        break;
+    }
+    if (not _lockFile) logger.error("Cannot lock an archive directory in %s, archiving is disabled", dirPath.toStdString());
+
+    _openBlock.count = 0;
+    _clock.start();
+    this->loadSegments();
+
+    //every session starts a new segment
+    this->openSegment();
+    this->removeOldSegments();
+    _thread = std::thread(&LoggerArchive::writerLoop, this);
+}
+
+LoggerArchive::~LoggerArchive(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        _done = true;
+    }
+    _queueCond.notify_one();
+    _thread.join();
+}
+
+void LoggerArchive::loadSegments(void)
+{
+    static auto &logger = Poco::Logger::get("PothosFlow.LoggerArchive");
+    QDir dir(_dirPath);
+    if (not dir.mkpath(".")) logger.error("Cannot create %s", _dirPath.toStdString());
+
+    for (const auto &name : dir.entryList(QStringList("*.log"), QDir::Files, QDir::Name))
+    {
+        bool ok = false;
+        Segment segment;
+        segment.number = QFileInfo(name).baseName().toULongLong(&ok);
+        if (not ok) continue;
+        segment.dataPath = segmentPath(_dirPath, segment.number, "log");
+        segment.indexPath = segmentPath(_dirPath, segment.number, "idx");
+
+        //load the block index from the last session,
+        //and cut off a partial entry from an unclean exit
+        QFile indexFile(segment.indexPath);
+        if (indexFile.open(QIODevice::ReadOnly))
+        {
+            QDataStream in(&indexFile);
+            in.setVersion(STREAM_VERSION);
+            Block block;
+            qint64 goodEnd = 0;
+            while (not in.atEnd() and readBlockIndex(in, block))
+            {
+                segment.blocks.push_back(block);
+                goodEnd = indexFile.pos();
+            }
+            indexFile.close();
+            if (_lockFile and indexFile.size() > goodEnd) indexFile.resize(goodEnd);
+        }
+
+        //recover the records of a block that was never sealed,
+        //and cut off a partial record from an unclean exit
+        const qint64 indexedEnd = segment.blocks.empty()?0:(segment.blocks.back().offset + segment.blocks.back().bytes);
+        QFile dataFile(segment.dataPath);
+        if (_lockFile and dataFile.size() > indexedEnd and dataFile.open(QIODevice::ReadWrite))
+        {
+            dataFile.seek(indexedEnd);
+            QDataStream in(&dataFile);
+            in.setVersion(STREAM_VERSION);
+            Block block;
+            block.offset = indexedEnd;
+            block.count = 0;
+            qint64 goodEnd = indexedEnd;
+            LoggerArchiveRecord record;
+            while (not in.atEnd() and decodeRecord(in, record))
+            {
+                block.firstTimeUs = (block.count == 0)?record.timeUs:std::min(block.firstTimeUs, record.timeUs);
+                block.lastTimeUs = (block.count == 0)?record.timeUs:std::max(block.lastTimeUs, record.timeUs);
+                if (not block.sources.contains(record.source)) block.sources.push_back(record.source);
+                block.count++;
+                goodEnd = dataFile.pos();
+            }
+            dataFile.resize(goodEnd);
+            block.bytes = goodEnd - indexedEnd;
+            if (block.count != 0 and indexFile.open(QIODevice::WriteOnly | QIODevice::Append))
+            {
+                writeBlockIndex(indexFile, block);
+                segment.blocks.push_back(block);
+            }
+        }
+        _segments.push_back(segment);
+    }
+}
+
+/***********************************************************************
+ * writer thread
+ **********************************************************************/
+void LoggerArchive::append(const std::vector<Poco::Message> &msgs)
+{
+    if (msgs.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        const auto room = MAX_QUEUE_MSGS - std::min(MAX_QUEUE_MSGS, _queue.size());
+        _queue.insert(_queue.end(), msgs.begin(), msgs.begin()+std::min(room, msgs.size()));
+    }
+    _queueCond.notify_one();
+}
+
+void LoggerArchive::writerLoop(void)
+{
+    std::unique_lock<std::mutex> lock(_queueMutex);
+    while (true)
+    {
+        _queueCond.wait_for(lock, std::chrono::milliseconds(BLOCK_SEAL_MS),
+            [this]{return _done or not _queue.empty();});
+        std::vector<Poco::Message> msgs;
+        msgs.swap(_queue);
+        const bool done = _done;
+        lock.unlock();
+
+        for (const auto &msg : msgs) this->writeMessage(msg);
+        if (done or (_clock.elapsed() - _openBlockStartMs) >= BLOCK_SEAL_MS) this->sealBlock();
+        if (done) break;
+
+        lock.lock();
+    }
+}
+
+void LoggerArchive::writeMessage(const Poco::Message &msg)
+{
+    if (not _dataFile.isOpen()) return;
+    const auto record = encodeRecord(msg);
+    const auto timeUs = msg.getTime().epochMicroseconds();
+    const auto source = QString::fromStdString(msg.getSource());
+
+    if (_openBlock.count == 0)
+    {
+        _openBlock.firstTimeUs = timeUs;
+        _openBlock.lastTimeUs = timeUs;
+        _openBlock.offset = _dataFile.pos();
+        _openBlock.bytes = 0;
+        _openBlock.sources.clear();
+        _openBlockStartMs = _clock.elapsed();
+    }
+    if (_dataFile.write(record) != record.size()) return;
+
+    //messages from different threads can arrive slightly out of order
+    _openBlock.firstTimeUs = std::min(_openBlock.firstTimeUs, timeUs);
+    _openBlock.lastTimeUs = std::max(_openBlock.lastTimeUs, timeUs);
+    _openBlock.bytes += record.size();
+    _openBlock.count++;
+    if (not _openBlock.sources.contains(source)) _openBlock.sources.push_back(source);
+
+    if (_openBlock.count >= BLOCK_MAX_RECORDS) this->sealBlock();
+    if (_dataFile.pos() >= _segmentBytes)
+    {
+        this->sealBlock();
+        this->openSegment();
+        this->removeOldSegments();
+    }
+}
+
+void LoggerArchive::sealBlock(void)
+{
+    if (_openBlock.count == 0) return;
+
+    //flush the records before they are indexed so readers can find them
+    _dataFile.flush();
+    writeBlockIndex(_indexFile, _openBlock);
+    _indexFile.flush();
+    {
+        std::lock_guard<std::mutex> lock(_indexMutex);
+        _segments.back().blocks.push_back(_openBlock);
+    }
+    _openBlock.count = 0;
+}
+
+void LoggerArchive::openSegment(void)
+{
+    static auto &logger = Poco::Logger::get("PothosFlow.LoggerArchive");
+    _dataFile.close();
+    _indexFile.close();
+    if (not _lockFile) return; //another instance owns the directory
+
+    Segment segment;
+    {
+        std::lock_guard<std::mutex> lock(_indexMutex);
+        segment.number = _segments.empty()?0:(_segments.back().number + 1);
+    }
+    segment.dataPath = segmentPath(_dirPath, segment.number, "log");
+    segment.indexPath = segmentPath(_dirPath, segment.number, "idx");
+
+    _dataFile.setFileName(segment.dataPath);
+    _indexFile.setFileName(segment.indexPath);
+    if (not _dataFile.open(QIODevice::WriteOnly | QIODevice::Truncate) or
+        not _indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        logger.error("Cannot open %s - %s", segment.dataPath.toStdString(), _dataFile.errorString().toStdString());
+        _dataFile.close();
+        _indexFile.close();
+    }
+
+    std::lock_guard<std::mutex> lock(_indexMutex);
+    _segments.push_back(segment);
+}
+
+void LoggerArchive::removeOldSegments(void)
+{
+    if (not _lockFile) return; //another instance owns the directory
+    std::vector<Segment> removed;
+    {
+        std::lock_guard<std::mutex> lock(_indexMutex);
+        while (_segments.size() > _maxSegments)
+        {
+            removed.push_back(_segments.front());
+            _segments.erase(_segments.begin());
+        }
+    }
+    for (const auto &segment : removed)
+    {
+        QFile::remove(segment.dataPath);
+        QFile::remove(segment.indexPath);
+    }
+}
+
+/***********************************************************************
+ * archive search
+ **********************************************************************/
+std::vector<LoggerArchiveRecord> LoggerArchive::readBlock(const quint64 number, const QString &dataPath, const Block &block)
+{
+    std::vector<LoggerArchiveRecord> records;
+    QFile dataFile(dataPath);
+    if (not dataFile.open(QIODevice::ReadOnly)) return records; //removed by rotation
+    if (not dataFile.seek(block.offset)) return records;
+    const auto bytes = dataFile.read(block.bytes);
+
+    QDataStream in(bytes);
+    in.setVersion(STREAM_VERSION);
+    LoggerArchiveRecord record;
+    record.pos.segment = number;
+    for (quint32 i = 0; i < block.count; i++)
+    {
+        record.pos.offset = block.offset + in.device()->pos();
+        if (not decodeRecord(in, record)) break;
+        records.push_back(record);
+    }
+    return records;
+}
+
+bool LoggerArchive::isMatch(const LoggerArchiveQuery &query, const Block &block)
+{
+    if (block.lastTimeUs < query.beginTimeUs) return false;
+    if (block.firstTimeUs > query.endTimeUs) return false;
+    if (query.source.isEmpty()) return true;
+    for (const auto &source : block.sources)
+    {
+        if (source.contains(query.source, Qt::CaseInsensitive)) return true;
+    }
+    return false;
+}
+
+bool LoggerArchive::isMatch(const LoggerArchiveQuery &query, const LoggerArchiveRecord &record)
+{
+    if (record.priority > query.maxPriority) return false;
+    if (record.timeUs < query.beginTimeUs) return false;
+    if (record.timeUs > query.endTimeUs) return false;
+    if (not record.source.contains(query.source, Qt::CaseInsensitive)) return false;
+    if (not record.text.contains(query.text, Qt::CaseInsensitive)) return false;
+    return true;
+}
+
+std::vector<LoggerArchiveRecord> LoggerArchive::query(const LoggerArchiveQuery &query) const
+{
+    //gather the candidate blocks from the index under the lock
+    struct Candidate
+    {
+        quint64 number;
+        QString dataPath;
+        Block block;
+    };
+    std::vector<Candidate> candidates;
+    {
+        std::lock_guard<std::mutex> lock(_indexMutex);
+        for (const auto &segment : _segments)
+        {
+            for (const auto &block : segment.blocks)
+            {
+                LoggerArchivePos blockBegin, blockEnd;
+                blockBegin.segment = blockEnd.segment = segment.number;
+                blockBegin.offset = block.offset;
+                blockEnd.offset = block.offset + block.bytes;
+                if (query.cursor.isValid() and query.older and not (blockBegin < query.cursor)) continue;
+                if (query.cursor.isValid() and not query.older and not (query.cursor < blockEnd)) continue;
+                if (not isMatch(query, block)) continue;
+                candidates.push_back(Candidate{segment.number, segment.dataPath, block});
+            }
+        }
+    }
+
+    //read the blocks in the paging direction until the page is full
+    std::vector<LoggerArchiveRecord> results;
+    if (query.older) std::reverse(candidates.begin(), candidates.end());
+    for (const auto &candidate : candidates)
+    {
+        auto records = readBlock(candidate.number, candidate.dataPath, candidate.block);
+        if (query.older) std::reverse(records.begin(), records.end());
+        for (const auto &record : records)
+        {
+            if (query.cursor.isValid() and query.older and not (record.pos < query.cursor)) continue;
+            if (query.cursor.isValid() and not query.older and not (query.cursor < record.pos)) continue;
+            if (not isMatch(query, record)) continue;
+            results.push_back(record);
+            if (results.size() >= query.limit) break;
+        }
+        if (results.size() >= query.limit) break;
+    }
+
+    if (query.older) std::reverse(results.begin(), results.end());
+    return results;
+}
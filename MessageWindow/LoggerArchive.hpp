@@ -0,0 +1,146 @@
+// Copyright (c) 2013-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <Poco/Message.h>
+#include <QString>
+#include <QStringList>
+#include <QFile>
+#include <QLockFile>
+#include <QElapsedTimer>
+#include <QtGlobal>
+#include <condition_variable>
+#include <cstddef>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <mutex>
+
+//! The position of a record in the archive, ordered by write order
+struct LoggerArchivePos
+{
+    LoggerArchivePos(void):
+        segment(0), offset(-1){}
+    quint64 segment;
+    qint64 offset;
+    bool isValid(void) const
+    {
+        return offset >= 0;
+    }
+    bool operator<(const LoggerArchivePos &rhs) const
+    {
+        if (segment != rhs.segment) return segment < rhs.segment;
+        return offset < rhs.offset;
+    }
+};
+
+//! A message read back from the archive
+struct LoggerArchiveRecord
+{
+    LoggerArchivePos pos;
+    qint64 timeUs;
+    int priority;
+    QString source;
+    QString text;
+};
+
+//! Search parameters for a page of archived records
+struct LoggerArchiveQuery
+{
+    LoggerArchiveQuery(void);
+    QString text; //!< substring of the message text, empty for all
+    QString source; //!< substring of the source name, empty for all
+    int maxPriority; //!< this priority or more severe
+    qint64 beginTimeUs; //!< records at or after this time
+    qint64 endTimeUs; //!< records at or before this time
+    LoggerArchivePos cursor; //!< page relative to this record, invalid for the ends
+    bool older; //!< page before the cursor (or the newest), else after (or the oldest)
+    size_t limit; //!< maximum records in the page
+};
+
+/*!
+ * The logger archive keeps the message history on disk.
+ * A lock file gives each running instance its own directory,
+ * other instances use numbered subdirectories of the given path.
+ * Messages are appended by a background writer thread
+ * into segment files that rotate at a maximum size,
+ * and the oldest segments are removed past a maximum count.
+ *
+ * Records are grouped into blocks. Each block is indexed with
+ * its time range and the sources it contains. The index stays in memory
+ * and is appended to a companion index file for the next session,
+ * so a search only reads the blocks that can possibly match.
+ */
+class LoggerArchive
+{
+public:
+    LoggerArchive(const QString &dirPath, const qint64 segmentBytes, const size_t maxSegments);
+
+    //! Writes out all pending messages before returning
+    ~LoggerArchive(void);
+
+    //! Queue a batch of messages for the writer thread
+    void append(const std::vector<Poco::Message> &msgs);
+
+    /*!
+     * Search for a page of records, this call is thread-safe.
+     * Only records in sealed blocks are found, the writer seals
+     * a block when it is full or shortly after the messages stop.
+     * \return matching records in the order that they were written
+     */
+    std::vector<LoggerArchiveRecord> query(const LoggerArchiveQuery &query) const;
+
+private:
+    struct Block
+    {
+        qint64 firstTimeUs;
+        qint64 lastTimeUs;
+        qint64 offset;
+        qint64 bytes;
+        quint32 count;
+        QStringList sources;
+    };
+
+    struct Segment
+    {
+        quint64 number;
+        QString dataPath;
+        QString indexPath;
+        std::vector<Block> blocks;
+    };
+
+    void loadSegments(void);
+    void writerLoop(void);
+    void writeMessage(const Poco::Message &msg);
+    void sealBlock(void);
+    void openSegment(void);
+    void removeOldSegments(void);
+
+    static std::vector<LoggerArchiveRecord> readBlock(const quint64 number, const QString &dataPath, const Block &block);
+    static bool isMatch(const LoggerArchiveQuery &query, const Block &block);
+    static bool isMatch(const LoggerArchiveQuery &query, const LoggerArchiveRecord &record);
+
+    QString _dirPath;
+    std::unique_ptr<QLockFile> _lockFile; //null when no directory could be locked
+    const qint64 _segmentBytes;
+    const size_t _maxSegments;
+
+    //segments and their blocks, shared with queries
+    mutable std::mutex _indexMutex;
+    std::vector<Segment> _segments;
+
+    //the writer thread's open segment and block
+    QFile _dataFile;
+    QFile _indexFile;
+    Block _openBlock;
+    QElapsedTimer _clock;
+    qint64 _openBlockStartMs;
+
+    //messages waiting for the writer thread
+    std::mutex _queueMutex;
+    std::condition_variable _queueCond;
+    std::vector<Poco::Message> _queue;
+    bool _done;
+    std::thread _thread;
+};
@@ -0,0 +1,182 @@
+// Copyright (c) 2013-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "MainWindow/IconUtils.hpp"
+#include "MessageWindow/LoggerArchiveView.hpp"
+#include "MessageWindow/LoggerModel.hpp"
+#include <QListView>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QDateTimeEdit>
+#include <QPushButton>
+#include <QLabel>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrent>
+#include <Poco/Timestamp.h>
+#include <functional> //std::bind
+
+static const size_t PAGE_SIZE = 1000;
+
+static std::vector<LoggerArchiveRecord> queryArchive(std::shared_ptr<LoggerArchive> archive, const LoggerArchiveQuery &query)
+{
+    return archive->query(query);
+}
+
+LoggerArchiveView::LoggerArchiveView(std::shared_ptr<LoggerArchive> archive, QWidget *parent):
+    QWidget(parent),
+    _archive(archive),
+    _textEdit(new QLineEdit(this)),
+    _sourceEdit(new QLineEdit(this)),
+    _levelBox(new QComboBox(this)),
+    _beforeCheck(new QCheckBox(tr("Before"), this)),
+    _beforeEdit(new QDateTimeEdit(QDateTime::currentDateTimeUtc(), this)),
+    _searchButton(new QPushButton(makeIconFromTheme("edit-find"), tr("Search"), this)),
+    _olderButton(new QPushButton(makeIconFromTheme("go-previous"), tr("Older"), this)),
+    _newerButton(new QPushButton(makeIconFromTheme("go-next"), tr("Newer"), this)),
+    _statusLabel(new QLabel(this)),
+    _model(new LoggerModel(PAGE_SIZE, this)),
+    _view(new QListView(this)),
+    _watcher(new QFutureWatcher<std::vector<LoggerArchiveRecord>>(this))
+{
+    auto layout = new QVBoxLayout(this);
+    layout->setContentsMargins(QMargins());
+    layout->setSpacing(0);
+
+    //search parameters
+    {
+        auto searchLayout = new QHBoxLayout();
+        layout->addLayout(searchLayout);
+        _textEdit->setPlaceholderText(tr("Search message text"));
+        _textEdit->setClearButtonEnabled(true);
+        _sourceEdit->setPlaceholderText(tr("Filter by source"));
+        _sourceEdit->setClearButtonEnabled(true);
+        _levelBox->addItem(tr("Trace"), int(Poco::Message::PRIO_TRACE));
+        _levelBox->addItem(tr("Debug"), int(Poco::Message::PRIO_DEBUG));
+        _levelBox->addItem(tr("Information"), int(Poco::Message::PRIO_INFORMATION));
+        _levelBox->addItem(tr("Notice"), int(Poco::Message::PRIO_NOTICE));
+        _levelBox->addItem(tr("Warning"), int(Poco::Message::PRIO_WARNING));
+        _levelBox->addItem(tr("Error"), int(Poco::Message::PRIO_ERROR));
+        _levelBox->addItem(tr("Critical"), int(Poco::Message::PRIO_CRITICAL));
+        _levelBox->setToolTip(tr("Show messages at this level or more severe"));
+        _beforeEdit->setTimeSpec(Qt::UTC); //matches the message times
+        _beforeEdit->setCalendarPopup(true);
+        _beforeEdit->setDisplayFormat("yyyy-MM-dd HH:mm:ss");
+        _beforeEdit->setEnabled(false);
+        connect(_beforeCheck, &QCheckBox::toggled, _beforeEdit, &QDateTimeEdit::setEnabled);
+        searchLayout->addWidget(_textEdit, 2);
+        searchLayout->addWidget(_sourceEdit, 1);
+        searchLayout->addWidget(_levelBox);
+        searchLayout->addWidget(_beforeCheck);
+        searchLayout->addWidget(_beforeEdit);
+        searchLayout->addWidget(_searchButton);
+        connect(_textEdit, &QLineEdit::returnPressed, this, &LoggerArchiveView::handleSearch);
+        connect(_sourceEdit, &QLineEdit::returnPressed, this, &LoggerArchiveView::handleSearch);
+        connect(_searchButton, &QPushButton::clicked, this, &LoggerArchiveView::handleSearch);
+    }
+
+    //one page of results
+    layout->addWidget(_view, 1);
+    _view->setModel(_model);
+    _view->setUniformItemSizes(true);
+    _view->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    _view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    _view->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    _view->setTextElideMode(Qt::ElideRight);
+
+    //paging controls
+    {
+        auto pageLayout = new QHBoxLayout();
+        layout->addLayout(pageLayout);
+        pageLayout->addWidget(_olderButton);
+        pageLayout->addWidget(_statusLabel, 1, Qt::AlignCenter);
+        pageLayout->addWidget(_newerButton);
+        _olderButton->setEnabled(false);
+        _newerButton->setEnabled(false);
+        connect(_olderButton, &QPushButton::clicked, this, &LoggerArchiveView::handleOlder);
+        connect(_newerButton, &QPushButton::clicked, this, &LoggerArchiveView::handleNewer);
+    }
+
+    connect(_watcher, &QFutureWatcher<std::vector<LoggerArchiveRecord>>::finished, this, &LoggerArchiveView::handleQueryDone);
+}
+
+void LoggerArchiveView::handleSearch(void)
+{
+    LoggerArchiveQuery query;
+    query.text = _textEdit->text();
+    query.source = _sourceEdit->text();
+    query.maxPriority = _levelBox->itemData(_levelBox->currentIndex()).toInt();
+    if (_beforeCheck->isChecked()) query.endTimeUs = _beforeEdit->dateTime().toMSecsSinceEpoch()*1000;
+    query.older = true;
+    query.limit = PAGE_SIZE;
+    this->submitQuery(query);
+}
+
+void LoggerArchiveView::handleOlder(void)
+{
+    if (_page.empty()) return;
+    auto query = _query;
+    query.cursor = _page.front().pos;
+    query.older = true;
+    this->submitQuery(query);
+}
+
+void LoggerArchiveView::handleNewer(void)
+{
+    if (_page.empty()) return;
+    auto query = _query;
+    query.cursor = _page.back().pos;
+    query.older = false;
+    this->submitQuery(query);
+}
+
+void LoggerArchiveView::submitQuery(const LoggerArchiveQuery &query)
+{
+    if (_watcher->isRunning()) return;
+    _query = query;
+    _searchButton->setEnabled(false);
+    _olderButton->setEnabled(false);
+    _newerButton->setEnabled(false);
+    _statusLabel->setText(tr("Searching..."));
+
+    //the job holds a reference to the archive in case this view goes away
+    _watcher->setFuture(QtConcurrent::run(std::bind(&queryArchive, _archive, query)));
+}
+
+void LoggerArchiveView::handleQueryDone(void)
+{
+    const auto records = _watcher->result();
+    _searchButton->setEnabled(true);
+
+    //paging past either end keeps the current page
+    if (records.empty() and _query.cursor.isValid())
+    {
+        _olderButton->setEnabled(not _page.empty());
+        _newerButton->setEnabled(not _page.empty());
+        _statusLabel->setText(_query.older?tr("No older messages"):tr("No newer messages"));
+        return;
+    }
+
+    _page = records;
+    std::vector<Poco::Message> msgs;
+    for (const auto &record : _page)
+    {
+        Poco::Message msg(record.source.toStdString(), record.text.toStdString(), Poco::Message::Priority(record.priority));
+        msg.setTime(Poco::Timestamp(record.timeUs));
+        msgs.push_back(msg);
+    }
+    _model->clear();
+    _model->appendBatch(msgs);
+    if (_query.older) _view->scrollToBottom();
+    else _view->scrollToTop();
+
+    _olderButton->setEnabled(not _page.empty());
+    _newerButton->setEnabled(not _page.empty());
+    if (_page.empty()) _statusLabel->setText(tr("No messages found"));
+    else _statusLabel->setText(tr("%1 messages from %2 to %3").arg(_page.size())
+        .arg(QDateTime::fromMSecsSinceEpoch(_page.front().timeUs/1000, Qt::UTC).toString("yyyy-MM-dd HH:mm:ss"))
+        .arg(QDateTime::fromMSecsSinceEpoch(_page.back().timeUs/1000, Qt::UTC).toString("yyyy-MM-dd HH:mm:ss")));
+}
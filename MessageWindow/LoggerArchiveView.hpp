@@ -0,0 +1,57 @@
+// Copyright (c) 2013-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include "MessageWindow/LoggerArchive.hpp"
+#include <QWidget>
+#include <memory>
+#include <vector>
+
+class LoggerModel;
+class QListView;
+class QComboBox;
+class QLineEdit;
+class QCheckBox;
+class QDateTimeEdit;
+class QPushButton;
+class QLabel;
+template <typename T> class QFutureWatcher;
+
+/*!
+ * The archive view searches the on-disk message history.
+ * Results are shown one page at a time, and the older and newer
+ * buttons page through the history relative to the current page.
+ * Searches run in a background thread to keep the GUI responsive.
+ */
+class LoggerArchiveView : public QWidget
+{
+    Q_OBJECT
+public:
+    LoggerArchiveView(std::shared_ptr<LoggerArchive> archive, QWidget *parent);
+
+private slots:
+    void handleSearch(void);
+    void handleOlder(void);
+    void handleNewer(void);
+    void handleQueryDone(void);
+
+private:
+    void submitQuery(const LoggerArchiveQuery &query);
+
+    std::shared_ptr<LoggerArchive> _archive;
+    QLineEdit *_textEdit;
+    QLineEdit *_sourceEdit;
+    QComboBox *_levelBox;
+    QCheckBox *_beforeCheck;
+    QDateTimeEdit *_beforeEdit;
+    QPushButton *_searchButton;
+    QPushButton *_olderButton;
+    QPushButton *_newerButton;
+    QLabel *_statusLabel;
+    LoggerModel *_model;
+    QListView *_view;
+    QFutureWatcher<std::vector<LoggerArchiveRecord>> *_watcher;
+    LoggerArchiveQuery _query;
+    std::vector<LoggerArchiveRecord> _page;
+};
@@ -1,16 +1,30 @@
-// Copyright (c) 2013-2017 Josh Blum
+// Copyright (c) 2013-2019 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #include "MessageWindow/LoggerChannel.hpp"
 #include <Poco/SplitterChannel.h>
 
-static const long QUEUE_MAX_DEPTH = 30;
+//! The window over which the per-source rate limit is applied
+static const Poco::Timestamp::TimeDiff RATE_WINDOW_US = 1000000;
 
-LoggerChannel::LoggerChannel(QObject *parent):
+LoggerChannel::SourceState::SourceState(void):
+    dropped(0),
+    repeats(0),
+    lastPrio(-1),
+    windowCount(0)
+{
+    return;
+}
+
+LoggerChannel::LoggerChannel(QObject *parent, const size_t capacity):
     QObject(parent),
     _logger(Poco::Logger::get("")),
     _oldLevel(_logger.getLevel()),
-    _splitter(dynamic_cast<Poco::SplitterChannel *>(_logger.getChannel()))
+    _splitter(dynamic_cast<Poco::SplitterChannel *>(_logger.getChannel())),
+    _ring(capacity),
+    _dropCount(0),
+    _rateLimit(0),
+    _coalesceRepeats(false)
 {
     _logger.setLevel(Poco::Message::PRIO_TRACE); //lowest level -> shows everything
     if (_splitter) _splitter->addChannel(this);
@@ -30,18 +44,95 @@ void LoggerChannel::disconnect(void)
 
 void LoggerChannel::log(const Poco::Message &msg)
 {
-    std::unique_lock<std::mutex> lock(_mutex);
-    _queue.push(msg);
+    const auto rateLimit = _rateLimit.load(std::memory_order_relaxed);
+    const bool coalesce = _coalesceRepeats.load(std::memory_order_relaxed);
+
+    //the common case only touches the ring buffer
+    if (rateLimit == 0 and not coalesce)
+    {
+        if (_ring.push(msg)) return;
+        std::lock_guard<std::mutex> lock(_sourceMutex);
+        return this->countDrop(_sourceStates[msg.getSource()]);
+    }
+
+    std::lock_guard<std::mutex> lock(_sourceMutex);
+    auto &state = _sourceStates[msg.getSource()];
+
+    //a back to back repeat is only counted
+    if (coalesce and state.lastPrio == int(msg.getPriority()) and state.lastText == msg.getText())
+    {
+        state.repeats++;
+        return;
+    }
+    this->pushRepeatNotice(msg.getSource(), state);
+    state.lastText = msg.getText();
+    state.lastPrio = int(msg.getPriority());
+
+    //rate limit the source over fixed windows
+    if (rateLimit != 0)
+    {
+        const Poco::Timestamp now;
+        if (now - state.windowStart >= RATE_WINDOW_US)
+        {
+            state.windowStart = now;
+            state.windowCount = 0;
+        }
+        if (++state.windowCount > rateLimit) return this->countDrop(state);
+    }
 
-    //remove oldest if we exceed the max depth
-    if (_queue.size() > QUEUE_MAX_DEPTH) _queue.pop();
+    if (not _ring.push(msg)) this->countDrop(state);
 }
 
 bool LoggerChannel::pop(Poco::Message &msg)
 {
-    std::unique_lock<std::mutex> lock(_mutex);
-    if (_queue.empty()) return false;
-    msg = _queue.front();
-    _queue.pop();
-    return true;
+    return _ring.pop(msg);
+}
+
+void LoggerChannel::setRateLimit(const size_t msgsPerSec)
+{
+    _rateLimit.store(msgsPerSec);
+}
+
+void LoggerChannel::setCoalesceRepeats(const bool enable)
+{
+    _coalesceRepeats.store(enable);
+}
+
+void LoggerChannel::flushRepeats(void)
+{
+    if (not _coalesceRepeats.load(std::memory_order_relaxed)) return;
+    std::lock_guard<std::mutex> lock(_sourceMutex);
+    for (auto &pair : _sourceStates) this->pushRepeatNotice(pair.first, pair.second);
+}
+
+size_t LoggerChannel::getDropCount(void) const
+{
+    return _dropCount.load();
+}
+
+std::map<std::string, size_t> LoggerChannel::getDropCounts(void) const
+{
+    std::map<std::string, size_t> dropCounts;
+    std::lock_guard<std::mutex> lock(_sourceMutex);
+    for (const auto &pair : _sourceStates)
+    {
+        if (pair.second.dropped != 0) dropCounts[pair.first] = pair.second.dropped;
+    }
+    return dropCounts;
+}
+
+void LoggerChannel::countDrop(SourceState &state)
+{
+    state.dropped++;
+    _dropCount++;
+}
+
+void LoggerChannel::pushRepeatNotice(const std::string &source, SourceState &state)
+{
+    if (state.repeats == 0) return;
+    const Poco::Message notice(source,
+        "Last message repeated " + std::to_string(state.repeats) + " times",
+        Poco::Message::Priority(state.lastPrio));
+    state.repeats = 0;
+    if (not _ring.push(notice)) this->countDrop(state);
 }
@@ -1,4 +1,4 @@
-// Copyright (c) 2013-2014 Josh Blum
+// Copyright (c) 2013-2019 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #pragma once
@@ -8,19 +8,30 @@
 #include <Poco/Message.h>
 #include <Poco/Logger.h>
 #include <Poco/AutoPtr.h>
-#include <queue>
+#include <Poco/Timestamp.h>
+#include "MessageWindow/LogRingBuffer.hpp"
+#include <string>
+#include <atomic>
 #include <mutex>
+#include <map>
 
 namespace Poco
 {
     class SplitterChannel;
 }
 
+/*!
+ * The logger channel collects messages from every logging thread
+ * into a bounded lock-free ring buffer for the message window.
+ * When the ring is full, new messages are dropped and counted per source.
+ * Optionally, each source can be rate limited (limited messages count as dropped),
+ * and a message repeated back to back by a source can be coalesced into a count.
+ */
 class LoggerChannel : public QObject, public Poco::Channel
 {
     Q_OBJECT
 public:
-    LoggerChannel(QObject *parent);
+    LoggerChannel(QObject *parent, const size_t capacity);
 
     ~LoggerChannel(void);
 
@@ -30,10 +41,45 @@ public:
 
     bool pop(Poco::Message &msg);
 
+    //! Limit each source to this many messages per second, 0 for no limit
+    void setRateLimit(const size_t msgsPerSec);
+
+    //! Coalesce a message repeated back to back by the same source
+    void setCoalesceRepeats(const bool enable);
+
+    //! Push a notice for every source with coalesced repeats
+    void flushRepeats(void);
+
+    //! Total number of messages dropped since construction
+    size_t getDropCount(void) const;
+
+    //! Number of messages dropped for each source
+    std::map<std::string, size_t> getDropCounts(void) const;
+
 private:
+    struct SourceState
+    {
+        SourceState(void);
+        size_t dropped;
+        size_t repeats;
+        std::string lastText;
+        int lastPrio;
+        Poco::Timestamp windowStart;
+        size_t windowCount;
+    };
+
+    void countDrop(SourceState &state);
+    void pushRepeatNotice(const std::string &source, SourceState &state);
+
     Poco::Logger &_logger;
     const int _oldLevel;
     Poco::AutoPtr<Poco::SplitterChannel> _splitter;
-    std::queue<Poco::Message> _queue;
-    std::mutex _mutex;
+    LogRingBuffer<Poco::Message> _ring;
+    std::atomic<size_t> _dropCount;
+    std::atomic<size_t> _rateLimit;
+    std::atomic<bool> _coalesceRepeats;
+
+    //only taken on drops, or when rate limiting or coalescing
+    mutable std::mutex _sourceMutex;
+    std::map<std::string, SourceState> _sourceStates;
 };
@@ -1,36 +1,94 @@
-// Copyright (c) 2013-2016 Josh Blum
+// Copyright (c) 2013-2019 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #include "MainWindow/IconUtils.hpp"
 #include "MessageWindow/LoggerDisplay.hpp"
 #include "MessageWindow/LoggerChannel.hpp"
-#include <QPlainTextEdit>
+#include "MessageWindow/LoggerModel.hpp"
+#include "MessageWindow/LoggerArchive.hpp"
+#include "MainWindow/MainSettings.hpp"
+#include <QListView>
+#include <QComboBox>
+#include <QLineEdit>
 #include <QScrollBar>
 #include <QToolButton>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QAction>
+#include <QApplication>
+#include <QClipboard>
 #include <QTimer>
-#include <Poco/DateTimeFormatter.h>
-#include <iostream>
+#include <utility> //move
 
 static const long CHECK_MSGS_TIMEOUT_MS = 100;
-static const size_t MAX_MSGS_PER_TIMEOUT = 3;
-static const size_t MAX_HISTORY_MSGS = 4096;
+static const size_t MAX_MSGS_PER_TIMEOUT = 4096;
+static const size_t MAX_HISTORY_MSGS = 65536;
+static const size_t DEFAULT_RING_CAPACITY = 4096;
 
-LoggerDisplay::LoggerDisplay(QWidget *parent):
+LoggerDisplay::LoggerDisplay(std::shared_ptr<LoggerArchive> archive, QWidget *parent):
     QStackedWidget(parent),
-    _channel(new LoggerChannel(nullptr)),
-    _text(new QPlainTextEdit(this)),
-    _clearButton(new QToolButton(_text)),
+    _channel(new LoggerChannel(nullptr, MainSettings::global()->value(
+        "MessageWindow/ringCapacity", qulonglong(DEFAULT_RING_CAPACITY)).toULongLong())),
+    _archive(archive),
+    _lastDropCount(0),
+    _model(new LoggerModel(MAX_HISTORY_MSGS, this)),
+    _view(new QListView(this)),
+    _levelBox(new QComboBox(this)),
+    _sourceEdit(new QLineEdit(this)),
+    _clearButton(new QToolButton(_view)),
     _timer(new QTimer(this))
 {
-    this->addWidget(_text);
-    _text->setReadOnly(true);
-    _text->setMaximumBlockCount(MAX_HISTORY_MSGS);
-    _text->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
+    auto page = new QWidget(this);
+    auto layout = new QVBoxLayout(page);
+    layout->setContentsMargins(QMargins());
+    layout->setSpacing(0);
+    this->addWidget(page);
+
+    //level and source filters
+    {
+        auto filterLayout = new QHBoxLayout();
+        layout->addLayout(filterLayout);
+        _levelBox->addItem(tr("Trace"), int(Poco::Message::PRIO_TRACE));
+        _levelBox->addItem(tr("Debug"), int(Poco::Message::PRIO_DEBUG));
+        _levelBox->addItem(tr("Information"), int(Poco::Message::PRIO_INFORMATION));
+        _levelBox->addItem(tr("Notice"), int(Poco::Message::PRIO_NOTICE));
+        _levelBox->addItem(tr("Warning"), int(Poco::Message::PRIO_WARNING));
+        _levelBox->addItem(tr("Error"), int(Poco::Message::PRIO_ERROR));
+        _levelBox->addItem(tr("Critical"), int(Poco::Message::PRIO_CRITICAL));
+        _levelBox->setToolTip(tr("Show messages at this level or more severe"));
+        _sourceEdit->setPlaceholderText(tr("Filter by source"));
+        _sourceEdit->setClearButtonEnabled(true);
+        filterLayout->addWidget(_levelBox);
+        filterLayout->addWidget(_sourceEdit, 1);
+        connect(_levelBox, SIGNAL(currentIndexChanged(int)), this, SLOT(handleFilterChanged(void)));
+        connect(_sourceEdit, &QLineEdit::textChanged, this, &LoggerDisplay::handleFilterChanged);
+    }
+
+    //the view only lays out the visible rows
+    layout->addWidget(_view, 1);
+    _view->setModel(_model);
+    _view->setUniformItemSizes(true);
+    _view->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    _view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    _view->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    _view->setTextElideMode(Qt::ElideRight);
+    _view->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
+
+    auto copyAction = new QAction(makeIconFromTheme("edit-copy"), tr("Copy"), _view);
+    copyAction->setShortcut(QKeySequence::Copy);
+    copyAction->setShortcutContext(Qt::WidgetShortcut);
+    _view->addAction(copyAction);
+    _view->setContextMenuPolicy(Qt::ActionsContextMenu);
+    connect(copyAction, &QAction::triggered, this, &LoggerDisplay::handleCopyRows);
 
     _clearButton->hide();
     _clearButton->setIcon(makeIconFromTheme("edit-clear-list"));
     _clearButton->setToolTip(tr("Clear message history"));
-    connect(_clearButton, SIGNAL(clicked(void)), _text, SLOT(clear(void)));
+    connect(_clearButton, SIGNAL(clicked(void)), _model, SLOT(clear(void)));
+
+    //optional flood protection for misbehaving sources
+    _channel->setRateLimit(MainSettings::global()->value("MessageWindow/rateLimit", 0).toULongLong());
+    _channel->setCoalesceRepeats(MainSettings::global()->value("MessageWindow/coalesceRepeats", false).toBool());
 
     connect(_timer, &QTimer::timeout, this, &LoggerDisplay::handleCheckMsgs);
     _timer->start(CHECK_MSGS_TIMEOUT_MS);
@@ -43,66 +101,69 @@ LoggerDisplay::~LoggerDisplay(void)
 
 void LoggerDisplay::handleCheckMsgs(void)
 {
-    const bool autoScroll = _text->verticalScrollBar()->value()+50 > _text->verticalScrollBar()->maximum();
+    const bool autoScroll = _view->verticalScrollBar()->value() == _view->verticalScrollBar()->maximum();
+
+    _channel->flushRepeats();
 
-    size_t numMsgs = 0;
+    //drain the channel into a single batch for the model
+    std::vector<Poco::Message> msgs;
+    this->handleDropCounts(msgs);
     Poco::Message msg;
-    while (_channel->pop(msg))
+    while (msgs.size() < MAX_MSGS_PER_TIMEOUT and _channel->pop(msg))
     {
-        this->handleLogMessage(msg);
-        if (++numMsgs == MAX_MSGS_PER_TIMEOUT) break;
+        msgs.push_back(std::move(msg));
     }
+    if (msgs.empty()) return;
 
-    if (numMsgs != 0 and autoScroll)
-    {
-        auto c =  _text->textCursor();
-        c.movePosition(QTextCursor::End);
-        _text->setTextCursor(c);
-    }
+    if (_archive) _archive->append(msgs);
+    _model->appendBatch(msgs);
+    if (autoScroll) _view->scrollToBottom();
 }
 
-void LoggerDisplay::handleLogMessage(const Poco::Message &msg)
+void LoggerDisplay::handleDropCounts(std::vector<Poco::Message> &msgs)
 {
-    QString color;
-    switch (msg.getPriority())
-    {
-    case Poco::Message::PRIO_INFORMATION: color = "black"; break;
-    case Poco::Message::PRIO_NOTICE: color = "green"; break;
-    case Poco::Message::PRIO_WARNING: color = "orange"; break;
-    case Poco::Message::PRIO_ERROR: color = "red"; break;
-    case Poco::Message::PRIO_CRITICAL: color = "red"; break;
-    case Poco::Message::PRIO_FATAL: color = "red"; break;
-    default: color = "black";
-    }
+    const auto dropCount = _channel->getDropCount();
+    if (dropCount == _lastDropCount) return;
+    _lastDropCount = dropCount;
 
-    QString sep(":");
-    const auto timeStr = Poco::DateTimeFormatter::format(msg.getTime(), "%H:%M:%s");
-
-    auto body = QString::fromStdString(msg.getText()).toHtmlEscaped();
-    if (body.count("\n") > 1)
+    //report the newly dropped messages of each source in line
+    for (const auto &pair : _channel->getDropCounts())
     {
-        sep = " &rArr;";
-        body = "<pre style='background-color:#eaecee;'>"+body+"</pre><br />";
+        auto &lastDropped = _lastDropCounts[pair.first];
+        if (pair.second == lastDropped) continue;
+        const auto numDropped = pair.second - lastDropped;
+        lastDropped = pair.second;
+        msgs.emplace_back(pair.first,
+            "Dropped " + std::to_string(numDropped) + " messages",
+            Poco::Message::PRIO_WARNING);
     }
 
-    auto line = QString("<font color=\"%1\"><b>[%2] %3%4</b></font> %5").arg(
-        color, QString::fromStdString(timeStr),
-        QString::fromStdString(msg.getSource()),
-        sep, body);
+    emit this->dropCountChanged(dropCount);
+}
+
+void LoggerDisplay::handleFilterChanged(void)
+{
+    _model->setMaxPriority(_levelBox->itemData(_levelBox->currentIndex()).toInt());
+    _model->setSourceFilter(_sourceEdit->text());
+    _view->scrollToBottom();
+}
 
-    _text->appendHtml(line);
+void LoggerDisplay::handleCopyRows(void)
+{
+    const auto text = _model->getRowsText(_view->selectionModel()->selectedIndexes());
+    if (not text.isEmpty()) QApplication::clipboard()->setText(text);
 }
 
 void LoggerDisplay::resizeEvent(QResizeEvent *event)
 {
-    _clearButton->move(_text->viewport()->width()-_clearButton->width(), 0);
+    _clearButton->move(_view->viewport()->width()-_clearButton->width(), 0);
     return QStackedWidget::resizeEvent(event);
 }
 
 void LoggerDisplay::enterEvent(QEvent *event)
 {
     _clearButton->show();
-    _clearButton->move(_text->viewport()->width()-_clearButton->width(), 0);
+    _clearButton->move(_view->viewport()->width()-_clearButton->width(), 0);
     return QStackedWidget::enterEvent(event);
 }
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2013-2015 Josh Blum
+// Copyright (c) 2013-2019 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #pragma once
@@ -6,9 +6,17 @@
 #include <QStackedWidget>
 #include <Poco/Message.h>
 #include <Poco/AutoPtr.h>
+#include <string>
+#include <memory>
+#include <vector>
+#include <map>
 
 class LoggerChannel;
-class QPlainTextEdit;
+class LoggerArchive;
+class LoggerModel;
+class QListView;
+class QComboBox;
+class QLineEdit;
 class QToolButton;
 class QTimer;
 
@@ -16,17 +24,29 @@ class LoggerDisplay : public QStackedWidget
 {
     Q_OBJECT
 public:
-    LoggerDisplay(QWidget *parent);
+    //! Create a display, messages are also written to the archive when provided
+    LoggerDisplay(std::shared_ptr<LoggerArchive> archive, QWidget *parent);
     ~LoggerDisplay(void);
 
+signals:
+    void dropCountChanged(const size_t dropCount);
+
 private slots:
     void handleCheckMsgs(void);
+    void handleFilterChanged(void);
+    void handleCopyRows(void);
 
 private:
-    void handleLogMessage(const Poco::Message &msg);
+    void handleDropCounts(std::vector<Poco::Message> &msgs);
 
     Poco::AutoPtr<LoggerChannel> _channel;
-    QPlainTextEdit *_text;
+    std::shared_ptr<LoggerArchive> _archive;
+    size_t _lastDropCount;
+    std::map<std::string, size_t> _lastDropCounts;
+    LoggerModel *_model;
+    QListView *_view;
+    QComboBox *_levelBox;
+    QLineEdit *_sourceEdit;
     QToolButton *_clearButton;
     QTimer *_timer;
 
@@ -0,0 +1,158 @@
+// Copyright (c) 2013-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "MessageWindow/LoggerModel.hpp"
+#include <QDateTime>
+#include <QColor>
+#include <QStringList>
+#include <algorithm> //sort
+
+LoggerModel::LoggerModel(const size_t maxEntries, QObject *parent):
+    QAbstractListModel(parent),
+    _store(maxEntries),
+    _maxPriority(Poco::Message::PRIO_TRACE)
+{
+    return;
+}
+
+void LoggerModel::appendBatch(const std::vector<Poco::Message> &msgs)
+{
+    if (msgs.empty()) return;
+
+    //a batch larger than the store only keeps its newest messages
+    const auto maxEntries = _store.maxEntries();
+    const size_t skip = (msgs.size() > maxEntries)?(msgs.size() - maxEntries):0;
+    const size_t numNew = msgs.size() - skip;
+
+    //trim the oldest entries and their rows to make room
+    const size_t numEntries = _store.endSeq() - _store.beginSeq();
+    const size_t numTrim = (numEntries + numNew > maxEntries)?(numEntries + numNew - maxEntries):0;
+    if (numTrim != 0)
+    {
+        const auto newBeginSeq = _store.beginSeq() + numTrim;
+        size_t numRows = 0;
+        while (numRows < _rows.size() and _rows[numRows] < newBeginSeq) numRows++;
+        if (numRows != 0) this->beginRemoveRows(QModelIndex(), 0, int(numRows)-1);
+        _rows.erase(_rows.begin(), _rows.begin()+numRows);
+        _store.trim(numTrim);
+        if (numRows != 0) this->endRemoveRows();
+    }
+
+    //append the entries, and insert the accepted ones as a single block of rows
+    std::vector<size_t> newRows;
+    for (size_t i = skip; i < msgs.size(); i++)
+    {
+        const auto seq = _store.endSeq();
+        _store.append(msgs[i]);
+        if (this->isAccepted(_store.at(seq))) newRows.push_back(seq);
+    }
+    if (newRows.empty()) return;
+
+    const int firstRow = int(_rows.size());
+    this->beginInsertRows(QModelIndex(), firstRow, firstRow+int(newRows.size())-1);
+    _rows.insert(_rows.end(), newRows.begin(), newRows.end());
+    this->endInsertRows();
+}
+
+void LoggerModel::setMaxPriority(const int priority)
+{
+    if (_maxPriority == priority) return;
+    _maxPriority = priority;
+    this->rebuildRows();
+}
+
+void LoggerModel::setSourceFilter(const QString &filter)
+{
+    if (_sourceFilter == filter) return;
+    _sourceFilter = filter;
+    this->rebuildRows();
+}
+
+void LoggerModel::clear(void)
+{
+    this->beginResetModel();
+    _store.clear();
+    _rows.clear();
+    this->endResetModel();
+}
+
+bool LoggerModel::isAccepted(const LoggerEntry &entry)
+{
+    if (entry.priority > _maxPriority) return false;
+
+    //the source filter is only matched once per source
+    while (_sourceAccepted.size() <= entry.sourceId)
+    {
+        const auto &name = _store.sourceName(quint32(_sourceAccepted.size()));
+        _sourceAccepted.push_back(_sourceFilter.isEmpty() or name.contains(_sourceFilter, Qt::CaseInsensitive));
+    }
+    return _sourceAccepted[entry.sourceId];
+}
+
+void LoggerModel::rebuildRows(void)
+{
+    this->beginResetModel();
+    _sourceAccepted.clear();
+    _rows.clear();
+    for (size_t seq = _store.beginSeq(); seq < _store.endSeq(); seq++)
+    {
+        if (this->isAccepted(_store.at(seq))) _rows.push_back(seq);
+    }
+    this->endResetModel();
+}
+
+QString LoggerModel::formatHeader(const LoggerEntry &entry) const
+{
+    const auto time = QDateTime::fromMSecsSinceEpoch(entry.timeUs/1000, Qt::UTC);
+    return QString("[%1] %2:").arg(time.toString("HH:mm:ss.zzz"), _store.sourceName(entry.sourceId));
+}
+
+QString LoggerModel::getRowsText(const QModelIndexList &indexes) const
+{
+    std::vector<int> rows;
+    for (const auto &index : indexes) rows.push_back(index.row());
+    std::sort(rows.begin(), rows.end());
+
+    QStringList lines;
+    for (const auto row : rows)
+    {
+        if (row < 0 or size_t(row) >= _rows.size()) continue;
+        const auto &entry = _store.at(_rows[row]);
+        lines.push_back(this->formatHeader(entry) + " " + entry.text);
+    }
+    return lines.join("\n");
+}
+
+int LoggerModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) return 0;
+    return int(_rows.size());
+}
+
+QVariant LoggerModel::data(const QModelIndex &index, int role) const
+{
+    if (not index.isValid() or size_t(index.row()) >= _rows.size()) return QVariant();
+    const auto &entry = _store.at(_rows[index.row()]);
+    const auto newline = entry.text.indexOf('\n');
+
+    //rows are a single line, long and multi-line messages show in full as a tool tip
+    if (role == Qt::DisplayRole)
+    {
+        if (newline < 0) return this->formatHeader(entry) + " " + entry.text;
+        return this->formatHeader(entry) + QString(" %1 ").arg(QChar(0x21D2)) + entry.text.left(newline) + " ...";
+    }
+
+    if (role == Qt::ToolTipRole) return entry.text;
+
+    if (role == Qt::ForegroundRole) switch (entry.priority)
+    {
+    case Poco::Message::PRIO_NOTICE: return QColor("green");
+    case Poco::Message::PRIO_WARNING: return QColor("orange");
+    case Poco::Message::PRIO_ERROR: return QColor("red");
+    case Poco::Message::PRIO_CRITICAL: return QColor("red");
+    case Poco::Message::PRIO_FATAL: return QColor("red");
+    default: return QColor("black");
+    }
+
+    return QVariant();
+}
@@ -0,0 +1,54 @@
+// Copyright (c) 2013-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include "MessageWindow/LoggerStore.hpp"
+#include <QAbstractListModel>
+#include <Poco/Message.h>
+#include <vector>
+#include <deque>
+
+/*!
+ * The logger model presents the entries of a logger store
+ * that pass the level and source filters as a list of rows.
+ * Messages are appended in batches, so a burst of messages
+ * costs a single row insertion and the view only lays out
+ * the rows that are visible on the screen.
+ */
+class LoggerModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    LoggerModel(const size_t maxEntries, QObject *parent);
+
+    //! Append a batch of messages, trimming the oldest entries to fit
+    void appendBatch(const std::vector<Poco::Message> &msgs);
+
+    //! Only show messages at this priority or more severe
+    void setMaxPriority(const int priority);
+
+    //! Only show messages whose source contains this text, empty for all
+    void setSourceFilter(const QString &filter);
+
+    //! The full text of the rows for copying to the clipboard
+    QString getRowsText(const QModelIndexList &indexes) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+
+public slots:
+    void clear(void);
+
+private:
+    bool isAccepted(const LoggerEntry &entry);
+    void rebuildRows(void);
+    QString formatHeader(const LoggerEntry &entry) const;
+
+    LoggerStore _store;
+    std::deque<size_t> _rows; //sequence numbers of the accepted entries
+    int _maxPriority;
+    QString _sourceFilter;
+    std::vector<bool> _sourceAccepted; //cached by source index
+};
@@ -0,0 +1,43 @@
+// Copyright (c) 2013-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "MessageWindow/LoggerStore.hpp"
+#include <algorithm> //min
+#include <utility> //move
+
+LoggerStore::LoggerStore(const size_t maxEntries):
+    _maxEntries(maxEntries),
+    _beginSeq(0)
+{
+    return;
+}
+
+void LoggerStore::append(const Poco::Message &msg)
+{
+    //intern the source name, there are only a handful of sources
+    auto it = _sourceIds.find(msg.getSource());
+    if (it == _sourceIds.end())
+    {
+        it = _sourceIds.emplace(msg.getSource(), quint32(_sourceNames.size())).first;
+        _sourceNames.push_back(QString::fromStdString(msg.getSource()));
+    }
+
+    LoggerEntry entry;
+    entry.timeUs = msg.getTime().epochMicroseconds();
+    entry.priority = quint8(msg.getPriority());
+    entry.sourceId = it->second;
+    entry.text = QString::fromStdString(msg.getText());
+    _entries.push_back(std::move(entry));
+}
+
+void LoggerStore::trim(const size_t count)
+{
+    const auto n = std::min(count, _entries.size());
+    _entries.erase(_entries.begin(), _entries.begin()+n);
+    _beginSeq += n;
+}
+
+void LoggerStore::clear(void)
+{
+    this->trim(_entries.size());
+}
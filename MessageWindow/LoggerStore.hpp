@@ -0,0 +1,85 @@
+// Copyright (c) 2013-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <Poco/Message.h>
+#include <QString>
+#include <QtGlobal>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+
+//! A compact log entry, the source is interned as an index
+struct LoggerEntry
+{
+    qint64 timeUs;
+    quint8 priority;
+    quint32 sourceId;
+    QString text;
+};
+
+/*!
+ * The logger store keeps a bounded history of log entries in memory.
+ * Every entry gets an increasing sequence number that stays valid
+ * until the entry is trimmed from the front of the store.
+ */
+class LoggerStore
+{
+public:
+    LoggerStore(const size_t maxEntries);
+
+    //! The maximum number of entries kept
+    size_t maxEntries(void) const
+    {
+        return _maxEntries;
+    }
+
+    //! Sequence number of the oldest entry
+    size_t beginSeq(void) const
+    {
+        return _beginSeq;
+    }
+
+    //! One past the sequence number of the newest entry
+    size_t endSeq(void) const
+    {
+        return _beginSeq + _entries.size();
+    }
+
+    //! Access an entry by sequence number
+    const LoggerEntry &at(const size_t seq) const
+    {
+        return _entries[seq - _beginSeq];
+    }
+
+    //! Append a message, the caller trims to make room
+    void append(const Poco::Message &msg);
+
+    //! Remove the oldest entries
+    void trim(const size_t count);
+
+    //! Remove all entries, the sequence numbers keep counting
+    void clear(void);
+
+    //! The source name for an interned source index
+    const QString &sourceName(const quint32 sourceId) const
+    {
+        return _sourceNames[sourceId];
+    }
+
+    //! The number of interned source names
+    size_t numSources(void) const
+    {
+        return _sourceNames.size();
+    }
+
+private:
+    const size_t _maxEntries;
+    size_t _beginSeq;
+    std::deque<LoggerEntry> _entries;
+    std::vector<QString> _sourceNames;
+    std::map<std::string, quint32> _sourceIds;
+};
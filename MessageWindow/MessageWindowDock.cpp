@@ -1,10 +1,18 @@
-// Copyright (c) 2013-2015 Josh Blum
+// Copyright (c) 2013-2019 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #include "MessageWindow/MessageWindowDock.hpp"
 #include "MessageWindow/LoggerDisplay.hpp"
+#include "MessageWindow/LoggerArchive.hpp"
+#include "MessageWindow/LoggerArchiveView.hpp"
+#include "MainWindow/MainSettings.hpp"
+#include <QStandardPaths>
 #include <QTabWidget>
 #include <QTabBar>
+#include <QDir>
+
+static const int DEFAULT_ARCHIVE_SEGMENT_MB = 16;
+static const int DEFAULT_ARCHIVE_MAX_SEGMENTS = 16;
 
 MessageWindowDock::MessageWindowDock(QWidget *parent):
     QDockWidget(parent),
@@ -19,5 +27,29 @@ MessageWindowDock::MessageWindowDock(QWidget *parent):
     _tabs->setMovable(true);
     _tabs->setUsesScrollButtons(true);
     _tabs->setTabPosition(QTabWidget::West);
-    _tabs->addTab(new LoggerDisplay(this), "");
+
+    //the on-disk message history
+    const auto settings = MainSettings::global();
+    if (settings->value("MessageWindow/archiveEnabled", true).toBool())
+    {
+        const QDir dataDir(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation));
+        _archive.reset(new LoggerArchive(dataDir.absoluteFilePath("LogArchive"),
+            qint64(settings->value("MessageWindow/archiveSegmentMB", DEFAULT_ARCHIVE_SEGMENT_MB).toInt())*1024*1024,
+            settings->value("MessageWindow/archiveMaxSegments", DEFAULT_ARCHIVE_MAX_SEGMENTS).toInt()));
+    }
+
+    auto display = new LoggerDisplay(_archive, this);
+    _tabs->addTab(display, tr("Messages"));
+    connect(display, &LoggerDisplay::dropCountChanged, this, &MessageWindowDock::handleDropCountChanged);
+
+    if (_archive)
+    {
+        _tabs->addTab(new LoggerArchiveView(_archive, this), tr("History"));
+        _tabs->tabBar()->show();
+    }
+}
+
+void MessageWindowDock::handleDropCountChanged(const size_t dropCount)
+{
+    this->setWindowTitle(tr("Message Window (%1 dropped)").arg(dropCount));
 }
@@ -1,11 +1,13 @@
-// Copyright (c) 2013-2014 Josh Blum
+// Copyright (c) 2013-2019 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #pragma once
 #include <Pothos/Config.hpp>
 #include <QDockWidget>
+#include <memory>
 
 class QTabWidget;
+class LoggerArchive;
 
 //! top level dock for message/logger text displays
 class MessageWindowDock : public QDockWidget
@@ -14,6 +16,10 @@ class MessageWindowDock : public QDockWidget
 public:
     MessageWindowDock(QWidget *parent);
 
+private slots:
+    void handleDropCountChanged(const size_t dropCount);
+
 private:
     QTabWidget *_tabs;
+    std::shared_ptr<LoggerArchive> _archive;
 };
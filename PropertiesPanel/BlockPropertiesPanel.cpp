@@ -7,6 +7,8 @@
 #include "BlockPropertiesPanel.hpp"
 #include "GraphObjects/GraphObject.hpp"
 #include "GraphObjects/GraphBlock.hpp"
+#include "GraphEditor/GraphDraw.hpp"
+#include "GraphEditor/GraphEditor.hpp"
 #include <Poco/Logger.h>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -19,13 +21,13 @@
 #include <QPainter>
 #include <QJsonDocument>
 
-/*!
- * We could remove the timer with the eval-background system.
- * But rather, it may still be useful to have an idle period
- * in which we accept new edit events before submitting changes.
- * So just leave this as a small number for the time-being.
- */
-static const long UPDATE_TIMER_MS = 500;
+//! The edited value as it will be written to the block
+static QString editValue(const PropertyEditWidget *editWidget)
+{
+    auto value = editWidget->value();
+    value.replace("\n", ""); //cannot handle multi-line values
+    return value;
+}
 
 BlockPropertiesPanel::BlockPropertiesPanel(GraphBlock *block, QWidget *parent):
     QWidget(parent),
@@ -40,10 +42,23 @@ BlockPropertiesPanel::BlockPropertiesPanel(GraphBlock *block, QWidget *parent):
     _evalTypesDesc(nullptr),
     _formLayout(nullptr),
     _propertiesTabs(nullptr),
+    _previewEval(nullptr),
     _block(block)
 {
     auto blockDesc = block->getBlockDesc();
 
+    //preview edited expressions against the current graph constants
+    {
+        const auto editor = block->draw()->getGraphEditor();
+        std::map<QString, QString> constants;
+        for (const auto &name : editor->listGlobals())
+        {
+            constants[name] = editor->getGlobalExpression(name);
+        }
+        _previewEval = new PropertyPreviewEval(editor->listGlobals(), constants, this);
+        connect(_previewEval, &PropertyPreviewEval::previewReady, this, &BlockPropertiesPanel::handlePreviewReady);
+    }
+
     //master layout for this widget
     _formLayout = makeFormLayout(this);
 
@@ -59,8 +74,7 @@ BlockPropertiesPanel::BlockPropertiesPanel(GraphBlock *block, QWidget *parent):
         _idLineEdit = new PropertyEditWidget(_block->getId(), QJsonObject(), "", this);
         _formLayout->addRow(_idLineEdit->makeFormLabel(tr("ID"), this), _idLineEdit);
         connect(_idLineEdit, &PropertyEditWidget::widgetChanged, this, &BlockPropertiesPanel::handleWidgetChanged);
-        connect(_idLineEdit, &PropertyEditWidget::widgetChanged, _block, &GraphBlock::triggerEvalEvent);
-        connect(_idLineEdit, &PropertyEditWidget::entryChanged, this, &BlockPropertiesPanel::handleWidgetChanged);
+        connect(_idLineEdit, &PropertyEditWidget::entryChanged, this, &BlockPropertiesPanel::handleEntryChanged);
         connect(_idLineEdit, &PropertyEditWidget::commitRequested, this, &BlockPropertiesPanel::handleCommit);
     }
 
@@ -103,8 +117,7 @@ BlockPropertiesPanel::BlockPropertiesPanel(GraphBlock *block, QWidget *parent):
         //create editable widget
         auto editWidget = new PropertyEditWidget(_block->getPropertyValue(propKey), paramDesc, editMode, this);
         connect(editWidget, SIGNAL(widgetChanged(void)), this, SLOT(handleWidgetChanged(void)));
-        connect(editWidget, SIGNAL(widgetChanged(void)), _block, SIGNAL(triggerEvalEvent(void)));
-        connect(editWidget, SIGNAL(entryChanged(void)), this, SLOT(handleWidgetChanged(void)));
+        connect(editWidget, SIGNAL(entryChanged(void)), this, SLOT(handleEntryChanged(void)));
         connect(editWidget, SIGNAL(commitRequested(void)), this, SLOT(handleCommit(void)));
         _propIdToEditWidget[propKey] = editWidget;
         editWidget->setToolTip(this->getParamDocString(propKey));
@@ -118,6 +131,13 @@ BlockPropertiesPanel::BlockPropertiesPanel(GraphBlock *block, QWidget *parent):
     {
         _affinityZoneOriginal = _block->getAffinityZone();
         _affinityZoneBox = AffinityZonesDock::global()->makeComboBox(this);
+        for (int i = 0; i < _affinityZoneBox->count(); i++)
+        {
+            if (_affinityZoneBox->itemData(i).toString() == _affinityZoneOriginal)
+            {
+                _affinityZoneBox->setCurrentIndex(i);
+            }
+        }
         _formLayout->addRow(_affinityZoneLabel, _affinityZoneBox);
         connect(_affinityZoneBox, SIGNAL(activated(const QString &)), this, SLOT(handleAffinityZoneChanged(const QString &)));
     }
@@ -263,27 +283,44 @@ void BlockPropertiesPanel::handleWidgetChanged(void)
 {
     if (_ignoreChanges) return;
 
-    //dump editor id to block
-    _block->setId(_idLineEdit->value());
-
-    //dump the affinity zone to block
-    _block->setAffinityZone(_affinityZoneBox->itemData(_affinityZoneBox->currentIndex()).toString());
-
-    //dump all values from edit widgets into the block's property values
+    //preview the edited expressions, the block is left alone until commit
     for (const auto &propKey : _block->getProperties())
     {
-        QString newValue = _propIdToEditWidget[propKey]->value();
-        newValue.replace("\n", ""); //cannot handle multi-line values
-        _block->setPropertyValue(propKey, newValue);
+        const auto value = editValue(_propIdToEditWidget[propKey]);
+        if (value == _block->getPropertyValue(propKey)) continue;
+        const auto it = _previewExprs.find(propKey);
+        if (it != _previewExprs.end() and it->second == value) continue;
+        _previewExprs[propKey] = value;
+        _previewEval->submit(propKey, value);
     }
 
     this->updateAllForms(); //quick update for labels
 }
 
+void BlockPropertiesPanel::handleEntryChanged(void)
+{
+    if (_ignoreChanges) return;
+    this->updateAllForms(); //quick update for labels
+}
+
+void BlockPropertiesPanel::handlePreviewReady(const PropertyPreview &preview)
+{
+    auto it = _propIdToEditWidget.find(preview.propKey);
+    if (it == _propIdToEditWidget.end()) return;
+    auto editWidget = it->second;
+
+    //the preview is stale when the user has typed since
+    if (editValue(editWidget) != preview.expr) return;
+
+    editWidget->setTypeStr(preview.typeStr);
+    editWidget->setErrorMsg(preview.errorMsg);
+    editWidget->setPreviewText(preview.errorMsg.isEmpty()?
+        QString("%1 = %2").arg(preview.typeStr, preview.valueStr) : QString());
+}
+
 void BlockPropertiesPanel::handleAffinityZoneChanged(const QString &)
 {
-    this->handleWidgetChanged();
-    emit _block->triggerEvalEvent();
+    this->updateAllForms();
 }
 
 void BlockPropertiesPanel::handleBlockEvalDone(void)
@@ -298,16 +335,12 @@ void BlockPropertiesPanel::handleParamDescChanged(const QString &key, const QJso
 
 void BlockPropertiesPanel::handleCancel(void)
 {
-    //reset values in block to original setting
-    _block->setId(_idLineEdit->initialValue());
+    //edits were only previewed, the block was never modified
     _idLineEdit->cancelEvents();
-    _block->setAffinityZone(_affinityZoneOriginal);
     for (const auto &propKey : _block->getProperties())
     {
-        _block->setPropertyValue(propKey, _propIdToEditWidget[propKey]->initialValue());
         _propIdToEditWidget[propKey]->cancelEvents();
     }
-    emit _block->triggerEvalEvent(); //update after change reversion
 
     //an edit widget return press signal may have us here,
     //and not the commit button, so make sure panel is deleted
@@ -331,10 +364,19 @@ void BlockPropertiesPanel::handleCommit(void)
     if (_idLineEdit->changed()) propertiesModified.push_back(tr("ID"));
 
     //was the affinity zone changed?
-    if (_affinityZoneOriginal != _block->getAffinityZone()) propertiesModified.push_back(tr("Affinity Zone"));
+    const auto affinityZone = _affinityZoneBox->itemData(_affinityZoneBox->currentIndex()).toString();
+    if (_affinityZoneOriginal != affinityZone) propertiesModified.push_back(tr("Affinity Zone"));
 
     if (propertiesModified.empty()) return this->handleCancel();
 
+    //write the edits into the block, the state change below re-evaluates it
+    _block->setId(_idLineEdit->value());
+    _block->setAffinityZone(affinityZone);
+    for (const auto &propKey : _block->getProperties())
+    {
+        _block->setPropertyValue(propKey, editValue(_propIdToEditWidget[propKey]));
+    }
+
     //stash the latest active tab to restore for next open
     if (_propertiesTabs != nullptr)
     {
@@ -411,24 +453,12 @@ void BlockPropertiesPanel::handleDocTabChanged(int index)
 
 void BlockPropertiesPanel::updateAllForms(void)
 {
-    //block id
-    if (_idLineEdit->value() != _block->getId())
-    {
-        _idLineEdit->setValue(_block->getId());
-    }
-
     //affinity zone
     {
-        for (int i = 0; i < _affinityZoneBox->count(); i++)
-        {
-            if (_affinityZoneBox->itemData(i).toString() == _block->getAffinityZone())
-            {
-                _affinityZoneBox->setCurrentIndex(i);
-            }
-        }
+        const auto affinityZone = _affinityZoneBox->itemData(_affinityZoneBox->currentIndex()).toString();
         _affinityZoneLabel->setText(QString("<b>%1%2</b>")
             .arg(tr("Affinity Zone"))
-            .arg((_affinityZoneOriginal != _block->getAffinityZone())?"*":""));
+            .arg((_affinityZoneOriginal != affinityZone)?"*":""));
     }
 
     //update block errors
@@ -458,13 +488,12 @@ void BlockPropertiesPanel::updatePropForms(const QString &propKey)
 {
     auto editWidget = _propIdToEditWidget[propKey];
 
+    //an edited value shows the preview evaluation instead
+    if (editValue(editWidget) != _block->getPropertyValue(propKey)) return;
+    _previewExprs.erase(propKey);
+
     //update the edit widget state
     editWidget->setTypeStr(_block->getPropertyTypeStr(propKey));
     editWidget->setErrorMsg(_block->getPropertyErrorMsg(propKey));
-
-    //set the editor's value if changed
-    if (_block->getPropertyValue(propKey) != editWidget->value())
-    {
-        editWidget->setValue(_block->getPropertyValue(propKey));
-    }
+    editWidget->setPreviewText("");
 }
@@ -8,6 +8,7 @@
 #include <QJsonObject>
 #include "GraphEditor/GraphState.hpp"
 #include "GraphObjects/GraphBlock.hpp"
+#include "PropertiesPanel/PropertyPreviewEval.hpp"
 #include <map>
 
 class GraphBlock;
@@ -37,6 +38,11 @@ private slots:
     //! Handle for all widget change events
     void handleWidgetChanged(void);
 
+    //! Handle for text entry events before the widget change
+    void handleEntryChanged(void);
+
+    void handlePreviewReady(const PropertyPreview &preview);
+
     void handleAffinityZoneChanged(const QString &);
 
     void handleBlockEvalDone(void);
@@ -80,5 +86,7 @@ private:
     std::map<QString, QFormLayout *> _paramLayouts;
     QTabWidget *_propertiesTabs;
     std::map<QWidget *, QString> _tabWidgetToTabName;
+    PropertyPreviewEval *_previewEval;
+    std::map<QString, QString> _previewExprs; //last expression submitted per property
     QPointer<GraphBlock> _block;
 };
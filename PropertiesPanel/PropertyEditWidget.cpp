@@ -26,6 +26,7 @@ PropertyEditWidget::PropertyEditWidget(const QString &initialValue, const QJsonO
     _initialValue(initialValue),
     _editWidget(nullptr),
     _errorLabel(new QLabel(this)),
+    _previewLabel(new QLabel(this)),
     _formLabel(nullptr),
     _entryTimer(new QTimer(this)),
     _editLayout(new QVBoxLayout(this)),
@@ -51,6 +52,7 @@ PropertyEditWidget::PropertyEditWidget(const QString &initialValue, const QJsonO
     _editLayout->setContentsMargins(QMargins());
     _editLayout->addLayout(_modeLayout);
     _editLayout->addWidget(_errorLabel);
+    _editLayout->addWidget(_previewLabel);
     _modeLayout->setSpacing(3);
     _modeLayout->setContentsMargins(QMargins());
     _modeLayout->addWidget(_modeButton, 0, Qt::AlignRight);
@@ -182,6 +184,12 @@ void PropertyEditWidget::setErrorMsg(const QString &errorMsg)
     this->updateInternals();
 }
 
+void PropertyEditWidget::setPreviewText(const QString &previewText)
+{
+    _previewText = previewText;
+    this->updateInternals();
+}
+
 void PropertyEditWidget::setBackgroundColor(const QColor &color)
 {
     _bgColor = color;
@@ -220,6 +228,11 @@ void PropertyEditWidget::updateInternals(void)
     _errorLabel->setText(QString("<span style='color:red;'><p><i>%1</i></p></span>").arg(_errorMsg.toHtmlEscaped()));
     _errorLabel->setWordWrap(true);
 
+    //update the preview label
+    _previewLabel->setVisible(not hasError and not _previewText.isEmpty());
+    _previewLabel->setText(QString("<span style='color:gray;'><i>%1</i></span>").arg(_previewText.toHtmlEscaped()));
+    _previewLabel->setWordWrap(true);
+
     //generate the form label
     auto formLabelText = QString("<span style='color:%1;'><b>%2%3</b></span>")
         .arg(hasError?"red":"black")
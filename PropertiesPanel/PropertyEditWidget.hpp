@@ -54,6 +54,9 @@ public:
     //! Set the error message from an evaluation
     void setErrorMsg(const QString &errorMsg);
 
+    //! Set the type and value text from a preview evaluation, empty to hide
+    void setPreviewText(const QString &previewText);
+
     //! Set the background color of the edit widget
     void setBackgroundColor(const QColor &color);
 
@@ -98,9 +101,11 @@ private:
     const QString _initialValue;
     QWidget *_editWidget;
     QLabel *_errorLabel;
+    QLabel *_previewLabel;
     QPointer<QLabel> _formLabel;
     QString _formLabelText;
     QString _errorMsg;
+    QString _previewText;
     QString _unitsStr;
     QTimer *_entryTimer;
     QVBoxLayout *_editLayout;
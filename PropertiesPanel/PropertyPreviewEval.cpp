@@ -0,0 +1,95 @@
+// Copyright (c) 2014-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "PropertiesPanel/PropertyPreviewEval.hpp"
+#include <Pothos/Util/EvalEnvironment.hpp>
+#include <Pothos/Exception.hpp>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrent>
+
+//! Long values (think large arrays) are cut short in the preview
+static const int PREVIEW_VALUE_MAX_CHARS = 64;
+
+/*!
+ * The constants and the evaluator that they are registered into.
+ * The evaluator is made on first use in the background thread,
+ * and only one preview at a time ever touches it.
+ */
+struct PropertyPreviewSnapshot
+{
+    QStringList constantNames;
+    std::map<QString, QString> constants;
+    std::unique_ptr<Pothos::Util::EvalEnvironment> evalEnv;
+};
+
+static PropertyPreview evalPropertyPreview(std::shared_ptr<PropertyPreviewSnapshot> snapshot, PropertyPreview preview)
+{
+    //register the constants once in the order of dependency,
+    //a bad constant only fails the expressions that use it
+    if (not snapshot->evalEnv)
+    {
+        snapshot->evalEnv.reset(new Pothos::Util::EvalEnvironment());
+        for (const auto &name : snapshot->constantNames)
+        {
+            try
+            {
+                snapshot->evalEnv->registerConstantExpr(name.toStdString(), snapshot->constants.at(name).toStdString());
+            }
+            catch (const Pothos::Exception &){}
+        }
+    }
+
+    try
+    {
+        const auto obj = snapshot->evalEnv->eval(preview.expr.toStdString());
+        preview.typeStr = QString::fromStdString(obj.getTypeString());
+        preview.valueStr = QString::fromStdString(obj.toString());
+        if (preview.valueStr.size() > PREVIEW_VALUE_MAX_CHARS)
+        {
+            preview.valueStr = preview.valueStr.left(PREVIEW_VALUE_MAX_CHARS) + "...";
+        }
+    }
+    catch (const Pothos::Exception &ex)
+    {
+        preview.errorMsg = QString::fromStdString(ex.message());
+    }
+    return preview;
+}
+
+PropertyPreviewEval::PropertyPreviewEval(const QStringList &constantNames, const std::map<QString, QString> &constants, QObject *parent):
+    QObject(parent),
+    _snapshot(new PropertyPreviewSnapshot()),
+    _watcher(new QFutureWatcher<PropertyPreview>(this))
+{
+    _snapshot->constantNames = constantNames;
+    _snapshot->constants = constants;
+    connect(_watcher, &QFutureWatcher<PropertyPreview>::finished, this, &PropertyPreviewEval::handleWatcherDone);
+}
+
+void PropertyPreviewEval::submit(const QString &propKey, const QString &expr)
+{
+    _pending[propKey] = expr;
+    this->startNext();
+}
+
+void PropertyPreviewEval::startNext(void)
+{
+    if (_watcher->isRunning()) return;
+    if (_pending.empty()) return;
+
+    PropertyPreview preview;
+    preview.propKey = _pending.begin()->first;
+    preview.expr = _pending.begin()->second;
+    _pending.erase(_pending.begin());
+
+    //the job holds its own reference to the snapshot,
+    //so it may safely finish after this object is gone
+    _watcher->setFuture(QtConcurrent::run(&evalPropertyPreview, _snapshot, preview));
+}
+
+void PropertyPreviewEval::handleWatcherDone(void)
+{
+    emit this->previewReady(_watcher->result());
+    this->startNext();
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2014-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <Pothos/Config.hpp>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <memory>
+#include <map>
+
+template <typename T> class QFutureWatcher;
+struct PropertyPreviewSnapshot;
+
+//! The outcome of evaluating a single property expression
+struct PropertyPreview
+{
+    QString propKey;
+    QString expr;
+    QString typeStr;
+    QString valueStr;
+    QString errorMsg;
+};
+
+/*!
+ * The property preview evaluator checks edited property expressions
+ * without touching the block or its evaluator in the eval engine.
+ * Each expression is evaluated alone in a background thread
+ * against a snapshot of the graph constants taken at construction.
+ * The constants are registered once and reused for every preview.
+ *
+ * Only one preview runs at a time, and only the latest expression
+ * of each property waits in the queue. The preview runs in this process,
+ * so it is a hint; the block evaluation on commit has the final word.
+ */
+class PropertyPreviewEval : public QObject
+{
+    Q_OBJECT
+public:
+    PropertyPreviewEval(const QStringList &constantNames, const std::map<QString, QString> &constants, QObject *parent);
+
+    //! Queue an expression for preview, replaces a pending one for the same property
+    void submit(const QString &propKey, const QString &expr);
+
+signals:
+    //! A preview completed, the expression may be out of date by now
+    void previewReady(const PropertyPreview &preview);
+
+private slots:
+    void handleWatcherDone(void);
+
+private:
+    void startNext(void);
+    std::shared_ptr<PropertyPreviewSnapshot> _snapshot;
+    QFutureWatcher<PropertyPreview> *_watcher;
+    std::map<QString, QString> _pending;
+};
@@ -0,0 +1,56 @@
+// Copyright (c) 2013-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Plugin.hpp>
+#include <Pothos/Managed.hpp>
+#include <Poco/File.h>
+#include <Poco/Exception.h>
+#include <sstream>
+#include <string>
+
+/***********************************************************************
+ * File modification info for the host running this module.
+ * The block cache uses this to notice a plugin module rebuilt in place,
+ * which keeps the same plugin paths, module path, and module version.
+ **********************************************************************/
+class FileInfo
+{
+public:
+    /*!
+     * Stat a newline separated list of paths, dump the result as JSON:
+     * [[size, modified time in microseconds], ...] in the order of the paths.
+     * A path that cannot be accessed reports [-1, -1].
+     */
+    static std::string statJson(const std::string &paths);
+};
+
+std::string FileInfo::statJson(const std::string &paths)
+{
+    std::istringstream iss(paths);
+    std::ostringstream oss;
+    oss << "[";
+    std::string path;
+    for (size_t i = 0; std::getline(iss, path); i++)
+    {
+        if (i != 0) oss << ",";
+        try
+        {
+            const Poco::File file(path);
+            oss << "[" << file.getSize() << "," << file.getLastModified().epochMicroseconds() << "]";
+        }
+        catch (const Poco::Exception &)
+        {
+            oss << "[-1,-1]";
+        }
+    }
+    oss << "]";
+    return oss.str();
+}
+
+pothos_static_block(registerFlowFileInfo)
+{
+    Pothos::ManagedClass()
+        .registerClass<FileInfo>()
+        .registerStaticMethod(POTHOS_FCN_TUPLE(FileInfo, statJson))
+        .commit("Pothos/Flow/FileInfo");
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2013-2019 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include <Pothos/Plugin.hpp>
+#include <Pothos/Managed.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+
+/***********************************************************************
+ * Live system load for the host running this module.
+ * This module is installed with the flow tool so that remote servers
+ * can report per-core utilization and load averages to the GUI.
+ * Per-NUMA node memory is already available from Pothos/System/NumaInfo.
+ **********************************************************************/
+class SystemLoad
+{
+public:
+    /*!
+     * Dump the load as a JSON string:
+     * {"loadAverage":[1m, 5m, 15m], "cpus":[{"cpu":N, "total":T, "idle":I}, ...]}
+     * The CPU times are the raw cumulative counters in clock ticks.
+     * Each client computes utilization from the difference
+     * between its own samples, so clients do not disturb each other.
+     */
+    static std::string dumpJson(void);
+};
+
+struct CpuTimes
+{
+    CpuTimes(void):
+        total(0), idle(0){}
+    unsigned long long total;
+    unsigned long long idle;
+};
+
+static std::map<int, CpuTimes> readCpuTimes(void)
+{
+    std::map<int, CpuTimes> times;
+    #ifdef __linux__
+    std::ifstream file("/proc/stat");
+    std::string line;
+    while (std::getline(file, line))
+    {
+        //per-cpu lines only, skip the aggregate "cpu " line
+        if (line.size() < 4 or line.compare(0, 3, "cpu") != 0 or line[3] == ' ') continue;
+        std::istringstream iss(line.substr(3));
+        int cpu(0); iss >> cpu;
+        CpuTimes t;
+        unsigned long long value(0);
+        for (size_t i = 0; iss >> value; i++)
+        {
+            t.total += value;
+            if (i == 3 or i == 4) t.idle += value; //idle and iowait
+        }
+        times[cpu] = t;
+    }
+    #endif
+    return times;
+}
+
+static std::vector<double> readLoadAverage(void)
+{
+    std::vector<double> load;
+    #ifdef __linux__
+    std::ifstream file("/proc/loadavg");
+    double value(0.0);
+    for (size_t i = 0; i < 3 and file >> value; i++) load.push_back(value);
+    #endif
+    return load;
+}
+
+std::string SystemLoad::dumpJson(void)
+{
+    std::ostringstream oss;
+    oss << "{\"loadAverage\":[";
+    const auto load = readLoadAverage();
+    for (size_t i = 0; i < load.size(); i++)
+    {
+        if (i != 0) oss << ",";
+        oss << load[i];
+    }
+    oss << "],\"cpus\":[";
+    bool first = true;
+    for (const auto &pair : readCpuTimes())
+    {
+        if (not first) oss << ",";
+        first = false;
+        oss << "{\"cpu\":" << pair.first << ",\"total\":" << pair.second.total << ",\"idle\":" << pair.second.idle << "}";
+    }
+    oss << "]}";
+    return oss.str();
+}
+
+pothos_static_block(registerFlowSystemLoad)
+{
+    Pothos::ManagedClass()
+        .registerClass<SystemLoad>()
+        .registerStaticMethod(POTHOS_FCN_TUPLE(SystemLoad, dumpJson))
+        .commit("Pothos/Flow/SystemLoad");
+}